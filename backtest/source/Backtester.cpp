@@ -0,0 +1,170 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "Backtester.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+Backtester::Backtester(std::shared_ptr<Strategy> strategy, const Settings &settings)
+    : strategy(std::move(strategy)), settings(settings) {
+    position.stopLossPercentage = this->strategy->getStopLossPercentage();
+}
+
+Backtester::Result Backtester::run(const CandleSeries &series, size_t begin, size_t end) {
+    if (ran) {
+        throw std::logic_error("A Backtester runs once, the strategy keeps the state of the candles it has seen.");
+    }
+    ran = true;
+
+    auto [tfSymbol, tfAmount] = strategy->getTimeframes()[0];
+    TimeFrame tf(tfSymbol, tfAmount);
+
+    if (series.interval() != 0 && series.interval() != tf.ticks * 60L) {
+        spdlog::error("Backtester::run - {} trades {} minute candles, got {} seconds apart", strategy->getName(),
+                      tf.ticks, series.interval());
+        throw std::invalid_argument("Candles don't match the timeframe of " + strategy->getName());
+    }
+
+    end = std::min(end, series.size());
+    begin = std::min(begin, end);
+    size_t warmup = settings.warmup >= 0 ? size_t(settings.warmup) : size_t(tf.amount);
+    size_t first = begin >= warmup ? begin - warmup : 0;
+    size_t tradeFrom = std::max(begin, first + warmup);
+
+    balance = settings.initialBalance;
+    peakEquity = balance;
+    result.initialBalance = balance;
+
+    // The strategies only take the candles newer than the last one they saw, so one reused candle does
+    auto latest = std::make_shared<Candle>();
+    std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> candles;
+    candles[tf].push_back(latest);
+
+    for (size_t i = first; i < end; i++) {
+        if (i >= tradeFrom) {
+            step(series, i);
+        }
+
+        *latest = series.at(i);
+        levelsReady = strategy->updateTriggerLevels(candles, levels);
+    }
+
+    if (position.qty != 0) {
+        fill(-position.qty, marketPrice(-position.qty, series.close[end - 1]), settings.takerFee,
+             series.timestamp[end - 1]);
+    }
+
+    result.candles = end > tradeFrom ? end - tradeFrom : 0;
+    result.finalBalance = balance;
+    return result;
+}
+
+void Backtester::step(const CandleSeries &series, const size_t &i) {
+    const double close = series.close[i];
+    const long timestamp = series.timestamp[i];
+
+    // The stop loss lives on the exchange, it triggers anywhere within the candle
+    if ((position.isLong() && series.low[i] < position.stopLossPrice)
+        || (position.isShort() && series.high[i] > position.stopLossPrice)) {
+        double price = position.isLong() ? std::min(series.open[i], position.stopLossPrice)
+                                         : std::max(series.open[i], position.stopLossPrice);
+        workingOrder.reset();
+        fill(-position.qty, marketPrice(-position.qty, price), settings.takerFee, timestamp, true);
+    }
+
+    if (workingOrder) {
+        checkWorkingOrder(series, i);
+    }
+
+    // Bybit::evaluateSignals with the trigger levels of the previous candle
+    if (levelsReady && position.qty != 0) {
+        if ((position.isLong() ? levels.longExit : levels.shortExit).firesAt(close) && !workingOrder) {
+            placeOrder(-position.qty, close, timestamp, true);
+        }
+    } else if (levelsReady && !workingOrder) {
+        if (levels.longEntry.firesAt(close)) {
+            placeOrder(strategy->getQty(), close, timestamp, false);
+        } else if (levels.shortEntry.firesAt(close)) {
+            placeOrder(-strategy->getQty(), close, timestamp, false);
+        }
+    }
+
+    double equity = balance;
+    if (position.qty != 0) {
+        equity += position.qty * (1 / position.entryPrice - 1 / close);
+    }
+
+    peakEquity = std::max(peakEquity, equity);
+    result.maxDrawdown = std::max(result.maxDrawdown, (peakEquity - equity) / peakEquity);
+}
+
+void Backtester::checkWorkingOrder(const CandleSeries &series, const size_t &i) {
+    Order &ord = *workingOrder;
+    const double close = series.close[i];
+
+    if ((ord.isBuy() && series.low[i] < ord.price) || (ord.isSell() && series.high[i] > ord.price)) {
+        Order filled = ord;
+        workingOrder.reset();
+        fill(filled.qty, filled.price, settings.makerFee, series.timestamp[i]);
+    } else if (close < ord.priceInterval.first || close > ord.priceInterval.second) {
+        Order cancelled = ord;
+        workingOrder.reset();
+
+        if (cancelled.reduce) {
+            fill(cancelled.qty, marketPrice(cancelled.qty, close), settings.takerFee, series.timestamp[i]);
+        }
+    } else {
+        ord.price = close;
+    }
+}
+
+void Backtester::placeOrder(const long &qty, const double &close, const long &timestamp, const bool &reduce) {
+    if (strategy->getOrderType() == "Market") {
+        fill(qty, marketPrice(qty, close), settings.takerFee, timestamp);
+    } else {
+        workingOrder = Order(close, qty, strategy->getSlippage(), reduce);
+    }
+}
+
+void Backtester::fill(const long &qty, const double &price, const double &feeRate, const long &timestamp,
+                      const bool &stopLoss) {
+    double fees = std::abs(qty) / price * feeRate;
+    balance -= fees;
+    result.fees += fees;
+
+    if (position.qty == 0) {
+        position.update(qty, price);
+        entryTime = timestamp;
+        entryFees = fees;
+        return;
+    }
+
+    // Orders either open a position or close all of it
+    double pnl = position.qty * (1 / position.entryPrice - 1 / price);
+    balance += pnl;
+    pnl -= entryFees + fees;
+
+    result.trades++;
+    result.stopLosses += stopLoss;
+
+    if (pnl > 0) {
+        result.wins++;
+        result.grossProfit += pnl;
+        result.largestWin = std::max(result.largestWin, pnl);
+    } else {
+        result.grossLoss -= pnl;
+        result.largestLoss = std::min(result.largestLoss, pnl);
+    }
+
+    if (settings.recordTrades) {
+        result.tradeLog.push_back({entryTime, timestamp, position.qty, position.entryPrice, price, pnl, stopLoss});
+    }
+
+    position.update(0, 0);
+}
@@ -0,0 +1,115 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_BACKTESTER_H
+#define BYTRA_BACKTESTER_H
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "../../bytra/source/Order.h"
+#include "../../bytra/source/Position.h"
+#include "../../bytra/source/strategies/Strategy.h"
+#include "CandleSeries.h"
+
+/** Replays candle history through a strategy the way Bybit trades it
+ * Every closed candle goes to Strategy::updateTriggerLevels, one candle at a time, and the trigger levels decide
+ * at the close of the next candle, like Bybit::checkSignals. Strategies that can't express their signals as
+ * trigger levels don't trade.
+ *
+ * Market orders fill at the close, Order::slippage against us. Limit orders are placed at the close and fill
+ * once a later candle trades through their price, they follow the close like the LimitOrderChaser follows the book
+ * and are cancelled once it leaves Order::priceInterval, a reduce only order is replaced by a market order then.
+ * The stop loss fills at its price, or at the open when the candle gapped past it. Contracts are inverse, like
+ * BTCUSD, so balance, fees and PnL are in BTC. A position still open after the last candle is closed at its close.
+ * */
+class Backtester {
+  public:
+    struct Settings {
+        double makerFee = -0.00025;  // negative is a rebate
+        double takerFee = 0.00075;
+        double initialBalance = 1.0;
+        long warmup = -1;  // candles that only feed the strategy, -1 for the amount of its first timeframe
+        bool recordTrades = false;
+    };
+
+    struct Trade {
+        long entryTime = 0;
+        long exitTime = 0;
+        long qty = 0;
+        double entryPrice = 0;
+        double exitPrice = 0;
+        double pnl = 0;  // after the fees of both fills
+        bool stopLoss = false;
+    };
+
+    struct Result {
+        size_t candles = 0;  // traded candles, without the warm-up
+        long trades = 0;
+        long wins = 0;
+        long stopLosses = 0;
+        double initialBalance = 0;
+        double finalBalance = 0;
+        double fees = 0;
+        double grossProfit = 0;
+        double grossLoss = 0;  // as a positive amount
+        double largestWin = 0;
+        double largestLoss = 0;
+        double maxDrawdown = 0;  // largest drop of the equity from its peak, as a fraction of the peak
+        std::vector<Trade> tradeLog;  // only with Settings::recordTrades
+
+        [[nodiscard]] double pnl() const { return finalBalance - initialBalance; }
+
+        [[nodiscard]] double returnRatio() const { return initialBalance > 0 ? pnl() / initialBalance : 0; }
+
+        [[nodiscard]] double winRate() const { return trades > 0 ? double(wins) / trades : 0; }
+
+        [[nodiscard]] double averageTrade() const { return trades > 0 ? (grossProfit - grossLoss) / trades : 0; }
+
+        [[nodiscard]] double profitFactor() const {
+            return grossLoss > 0 ? grossProfit / grossLoss : std::numeric_limits<double>::infinity();
+        }
+    };
+
+  private:
+    std::shared_ptr<Strategy> strategy;
+    Settings settings;
+    bool ran = false;
+
+    Position position;
+    std::optional<Order> workingOrder;
+    TriggerLevels levels;
+    bool levelsReady = false;
+    long entryTime = 0;
+    double entryFees = 0;
+    double balance = 0;
+    double peakEquity = 0;
+    Result result;
+
+    void step(const CandleSeries &series, const size_t &i);
+
+    void checkWorkingOrder(const CandleSeries &series, const size_t &i);
+
+    void placeOrder(const long &qty, const double &close, const long &timestamp, const bool &reduce);
+
+    void fill(const long &qty, const double &price, const double &feeRate, const long &timestamp,
+              const bool &stopLoss = false);
+
+    [[nodiscard]] double marketPrice(const long &qty, const double &price) const {
+        return qty > 0 ? price + strategy->getSlippage() : price - strategy->getSlippage();
+    }
+
+  public:
+    // The strategy is expected to be fresh, its indicators keep the state of the candles it has seen
+    Backtester(std::shared_ptr<Strategy> strategy, const Settings &settings);
+
+    // Trades candles begin up to end of the series. The warm-up candles right before begin only feed the strategy,
+    // when there aren't that many the first candles of the range make up for it.
+    Result run(const CandleSeries &series, size_t begin = 0, size_t end = std::numeric_limits<size_t>::max());
+};
+
+#endif  // BYTRA_BACKTESTER_H
@@ -0,0 +1,85 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "CandleSeries.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+CandleSeries CandleSeries::loadCsv(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file) {
+        spdlog::error("CandleSeries::loadCsv - can't open {}", path);
+        throw std::runtime_error("Can't open candle file: " + path);
+    }
+
+    // Read in one go and parse in place, getline and streams are the slow part with millions of lines
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string data = buffer.str();
+
+    CandleSeries series;
+    series.reserve(data.size() / 48);
+    const char *pos = data.c_str();
+    const char *end = pos + data.size();
+    long line = 0;
+
+    while (pos < end) {
+        line++;
+        const char *lineEnd = pos;
+        while (lineEnd < end && *lineEnd != '\n') {
+            lineEnd++;
+        }
+
+        // Header and empty lines don't start with a digit
+        if (std::isdigit(static_cast<unsigned char>(*pos))) {
+            Candle candle{};
+            auto parsed = std::from_chars(pos, lineEnd, candle.timestamp);
+            double *fields[] = {&candle.open, &candle.high, &candle.low, &candle.close, &candle.volume};
+            size_t count = 0;
+
+            while (count < 5 && parsed.ec == std::errc() && parsed.ptr < lineEnd && *parsed.ptr == ',') {
+                parsed = std::from_chars(parsed.ptr + 1, lineEnd, *fields[count++]);
+            }
+
+            if (count < 5 || parsed.ec != std::errc() || (parsed.ptr < lineEnd && *parsed.ptr != '\r')) {
+                spdlog::error("CandleSeries::loadCsv - bad line {} in {}", line, path);
+                throw std::runtime_error("Bad candle on line " + std::to_string(line) + " of " + path);
+            }
+
+            if (!series.empty() && candle.timestamp <= series.timestamp.back()) {
+                spdlog::error("CandleSeries::loadCsv - line {} in {} is out of order", line, path);
+                throw std::runtime_error("Candles out of order on line " + std::to_string(line) + " of " + path);
+            }
+
+            series.push_back(candle);
+        }
+
+        pos = lineEnd + 1;
+    }
+
+    return series;
+}
+
+void CandleSeries::reserve(const size_t &count) {
+    for (auto *column : {&open, &high, &low, &close, &volume}) {
+        column->reserve(count);
+    }
+    timestamp.reserve(count);
+}
+
+void CandleSeries::push_back(const Candle &candle) {
+    timestamp.push_back(candle.timestamp);
+    open.push_back(candle.open);
+    high.push_back(candle.high);
+    low.push_back(candle.low);
+    close.push_back(candle.close);
+    volume.push_back(candle.volume);
+}
@@ -0,0 +1,48 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_CANDLESERIES_H
+#define BYTRA_CANDLESERIES_H
+
+#include <string>
+#include <vector>
+
+#include "../../bytra/source/Candle.h"
+
+/** Candle history stored column by column
+ * A backtest only walks the candles front to back, keeping every field in an array of its own keeps the
+ * reads sequential and the memory at 48 bytes per candle without a pointer per candle. Read only once loaded,
+ * so any number of backtests can share one series.
+ * */
+class CandleSeries {
+  public:
+    std::vector<long> timestamp;  // open time, in seconds
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<double> volume;
+
+    CandleSeries() = default;
+
+    // Lines of timestamp,open,high,low,close,volume, a header line is skipped
+    static CandleSeries loadCsv(const std::string &path);
+
+    void reserve(const size_t &count);
+
+    void push_back(const Candle &candle);
+
+    [[nodiscard]] Candle at(const size_t &i) const {
+        return {open[i], high[i], low[i], close[i], volume[i], timestamp[i]};
+    }
+
+    [[nodiscard]] size_t size() const { return timestamp.size(); }
+
+    [[nodiscard]] bool empty() const { return timestamp.empty(); }
+
+    // Seconds between the first two candles, 0 with less than two candles
+    [[nodiscard]] long interval() const { return size() < 2 ? 0 : timestamp[1] - timestamp[0]; }
+};
+
+#endif  // BYTRA_CANDLESERIES_H
@@ -0,0 +1,154 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "Optimizer.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+Optimizer::Optimizer(const CandleSeries &series, StrategyFactory factory, std::vector<ParameterRange> ranges,
+                     const Settings &settings)
+    : series(series),
+      factory(std::move(factory)),
+      ranges(std::move(ranges)),
+      settings(settings),
+      pool(settings.threads) {
+    // Thousands of trade logs would only take up memory, the statistics are what gets compared
+    this->settings.backtest.recordTrades = false;
+}
+
+std::vector<StrategyParameters> Optimizer::candidates() const {
+    size_t gridSize = 1;
+    for (auto &range : ranges) {
+        gridSize *= range.count();
+    }
+
+    std::vector<std::vector<size_t>> points;
+
+    if (settings.randomSamples == 0 || settings.randomSamples >= gridSize) {
+        // Count through the grid like an odometer, the last range turning fastest
+        std::vector<size_t> point(ranges.size(), 0);
+
+        for (size_t n = 0; n < gridSize; n++) {
+            points.push_back(point);
+
+            for (size_t i = ranges.size(); i-- > 0;) {
+                if (++point[i] < ranges[i].count()) {
+                    break;
+                }
+                point[i] = 0;
+            }
+        }
+    } else {
+        std::mt19937 rng(settings.seed);
+        std::set<std::vector<size_t>> seen;
+
+        while (points.size() < settings.randomSamples) {
+            std::vector<size_t> point;
+            for (auto &range : ranges) {
+                point.push_back(std::uniform_int_distribution<size_t>(0, range.count() - 1)(rng));
+            }
+
+            if (seen.insert(point).second) {
+                points.push_back(point);
+            }
+        }
+    }
+
+    std::vector<StrategyParameters> candidates;
+
+    for (auto &point : points) {
+        StrategyParameters parameters;
+        for (size_t i = 0; i < ranges.size(); i++) {
+            parameters[ranges[i].name] = ranges[i].value(point[i]);
+        }
+
+        // Combinations like a fast average slower than the slow one are rejected by the strategy
+        try {
+            factory(parameters);
+            candidates.push_back(std::move(parameters));
+        } catch (const std::invalid_argument &) {
+        }
+    }
+
+    return candidates;
+}
+
+std::vector<Optimizer::Run> Optimizer::sweep(const std::vector<StrategyParameters> &candidates, const size_t &begin,
+                                             const size_t &end) {
+    std::vector<Run> runs(candidates.size());
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+        submit(candidates[i], begin, end, runs[i]);
+    }
+    pool.wait();
+
+    std::stable_sort(runs.begin(), runs.end(), [](const Run &a, const Run &b) { return a.score > b.score; });
+    return runs;
+}
+
+std::vector<Optimizer::Fold> Optimizer::walkForward(const std::vector<StrategyParameters> &candidates,
+                                                    const size_t &inSample, const size_t &outOfSample) {
+    std::vector<Fold> folds;
+
+    for (size_t begin = 0; outOfSample > 0 && begin + inSample + outOfSample <= series.size(); begin += outOfSample) {
+        Fold fold;
+        fold.begin = begin;
+        fold.split = begin + inSample;
+        fold.end = begin + inSample + outOfSample;
+        folds.push_back(fold);
+    }
+
+    if (folds.empty() || candidates.empty()) {
+        throw std::invalid_argument("Walk-forward needs candidates and candles for at least one fold.");
+    }
+
+    // The in-sample backtests of all folds go to the pool at once, so no worker waits for the slowest of a fold
+    std::vector<std::vector<Run>> inSampleRuns(folds.size(), std::vector<Run>(candidates.size()));
+
+    for (size_t f = 0; f < folds.size(); f++) {
+        for (size_t i = 0; i < candidates.size(); i++) {
+            submit(candidates[i], folds[f].begin, folds[f].split, inSampleRuns[f][i]);
+        }
+    }
+    pool.wait();
+
+    std::vector<Run> outOfSampleRuns(folds.size());
+
+    for (size_t f = 0; f < folds.size(); f++) {
+        auto &runs = inSampleRuns[f];
+        folds[f].inSample = *std::max_element(runs.begin(), runs.end(),
+                                              [](const Run &a, const Run &b) { return a.score < b.score; });
+        submit(folds[f].inSample.parameters, folds[f].split, folds[f].end, outOfSampleRuns[f]);
+    }
+    pool.wait();
+
+    for (size_t f = 0; f < folds.size(); f++) {
+        folds[f].outOfSample = outOfSampleRuns[f].result;
+    }
+
+    return folds;
+}
+
+double Optimizer::score(const Backtester::Result &result) const {
+    switch (settings.objective) {
+        case Objective::ReturnOverDrawdown:
+            // A drawdown below 0.1% doesn't make a strategy any safer, it just didn't trade much
+            return result.returnRatio() / std::max(result.maxDrawdown, 0.001);
+        case Objective::Return:
+        default:
+            return result.returnRatio();
+    }
+}
+
+void Optimizer::submit(const StrategyParameters &parameters, const size_t &begin, const size_t &end, Run &run) {
+    pool.submit([this, &parameters, begin, end, &run] {
+        run.parameters = parameters;
+        run.result = Backtester(factory(parameters), settings.backtest).run(series, begin, end);
+        run.score = score(run.result);
+    });
+}
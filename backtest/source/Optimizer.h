@@ -0,0 +1,93 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_OPTIMIZER_H
+#define BYTRA_OPTIMIZER_H
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "../../bytra/source/strategies/Strategies.h"
+#include "Backtester.h"
+#include "CandleSeries.h"
+#include "WorkStealingPool.h"
+
+// Values min, min + step, ... up to max
+struct ParameterRange {
+    std::string name;
+    double min = 0;
+    double max = 0;
+    double step = 1;
+
+    [[nodiscard]] size_t count() const {
+        return step > 0 && max > min ? size_t(std::floor((max - min) / step + 1e-9)) + 1 : 1;
+    }
+
+    [[nodiscard]] double value(const size_t &i) const { return min + double(i) * step; }
+};
+
+/** Searches strategy parameters with backtests on all cores
+ * Every backtest is a task on the WorkStealingPool with a strategy of its own, the candles are shared read only.
+ * The parameters are either the whole grid of the ranges or a random sample of it, combinations the strategy
+ * rejects are left out.
+ *
+ * Walk-forward splits the candles into folds of in-sample candles followed by out-of-sample candles, each fold
+ * moving on by the out-of-sample length. The best parameters in-sample are backtested on the out-of-sample candles
+ * right after, so the out-of-sample results tell how the search itself holds up on candles it hasn't seen.
+ * */
+class Optimizer {
+  public:
+    enum class Objective { Return, ReturnOverDrawdown };
+
+    struct Settings {
+        Backtester::Settings backtest;
+        Objective objective = Objective::Return;
+        size_t randomSamples = 0;  // 0 runs the whole grid
+        unsigned seed = 42;
+        size_t threads = 0;  // 0 for one per hardware thread
+    };
+
+    struct Run {
+        StrategyParameters parameters;
+        Backtester::Result result;
+        double score = 0;
+    };
+
+    struct Fold {
+        size_t begin = 0;
+        size_t split = 0;  // first out-of-sample candle
+        size_t end = 0;
+        Run inSample;  // the best parameters
+        Backtester::Result outOfSample;
+    };
+
+  private:
+    const CandleSeries &series;
+    StrategyFactory factory;
+    std::vector<ParameterRange> ranges;
+    Settings settings;
+    WorkStealingPool pool;
+
+    [[nodiscard]] double score(const Backtester::Result &result) const;
+
+    void submit(const StrategyParameters &parameters, const size_t &begin, const size_t &end, Run &run);
+
+  public:
+    Optimizer(const CandleSeries &series, StrategyFactory factory, std::vector<ParameterRange> ranges,
+              const Settings &settings);
+
+    [[nodiscard]] std::vector<StrategyParameters> candidates() const;
+
+    // Backtests every candidate on candles begin up to end, best score first
+    std::vector<Run> sweep(const std::vector<StrategyParameters> &candidates, const size_t &begin,
+                           const size_t &end);
+
+    std::vector<Fold> walkForward(const std::vector<StrategyParameters> &candidates, const size_t &inSample,
+                                  const size_t &outOfSample);
+
+    [[nodiscard]] size_t threads() const { return pool.size(); }
+};
+
+#endif  // BYTRA_OPTIMIZER_H
@@ -0,0 +1,123 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <utility>
+
+thread_local const WorkStealingPool *WorkStealingPool::currentPool = nullptr;
+thread_local size_t WorkStealingPool::currentQueue = 0;
+
+WorkStealingPool::WorkStealingPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    for (size_t i = 0; i < threads; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    for (size_t i = 0; i < threads; i++) {
+        workers.emplace_back(&WorkStealingPool::run, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    size_t index = currentPool == this ? currentQueue : nextQueue++ % queues.size();
+    unfinished++;
+    queued++;
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    // Taking the lock orders the notify after a worker that is about to sleep checked queued
+    { std::lock_guard<std::mutex> lock(mutex); }
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this] { return unfinished == 0; });
+
+    if (error) {
+        std::rethrow_exception(std::exchange(error, nullptr));
+    }
+}
+
+bool WorkStealingPool::runOne(const size_t &index) {
+    std::function<void()> task;
+
+    // Newest task of our own queue first, then the oldest of the next queue that has one
+    for (size_t i = 0; i < queues.size() && !task; i++) {
+        WorkQueue &queue = *queues[(index + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+
+    queued--;
+
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+
+    if (--unfinished == 0) {
+        { std::lock_guard<std::mutex> lock(mutex); }
+        allDone.notify_all();
+    }
+
+    return true;
+}
+
+void WorkStealingPool::run(const size_t &index) {
+    currentPool = this;
+    currentQueue = index;
+
+    for (;;) {
+        if (runOne(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        workAvailable.wait(lock, [this] { return stopping || queued > 0; });
+
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_WORKSTEALINGPOOL_H
+#define BYTRA_WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** Thread pool where every worker has a queue of its own
+ * Tasks are spread over the queues round robin, a task submitted by a worker goes to its own queue. A worker takes
+ * its newest task first and steals the oldest task of another queue once its own is empty, so workers that got
+ * the short tasks help out the others instead of idling. Each queue has its own lock, workers only contend
+ * while stealing.
+ * */
+class WorkStealingPool {
+  private:
+    struct alignas(64) WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    static thread_local const WorkStealingPool *currentPool;
+    static thread_local size_t currentQueue;
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};      // tasks waiting in the queues
+    std::atomic<size_t> unfinished{0};  // tasks submitted and not finished yet
+    std::atomic<size_t> nextQueue{0};
+
+    std::mutex mutex;  // guards the fields below and the waits on the condition variables
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    bool stopping = false;
+    std::exception_ptr error;  // first exception thrown by a task
+
+    bool runOne(const size_t &index);
+
+    void run(const size_t &index);
+
+  public:
+    // 0 threads starts one per hardware thread
+    explicit WorkStealingPool(size_t threads = 0);
+
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    void submit(std::function<void()> task);
+
+    // Blocks until every submitted task ran and rethrows the first exception one of them threw.
+    // Not to be called from a task.
+    void wait();
+
+    [[nodiscard]] size_t size() const { return workers.size(); }
+};
+
+#endif  // BYTRA_WORKSTEALINGPOOL_H
@@ -0,0 +1,247 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cli/CLI11.hpp>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <toml++/toml.hpp>
+#include <vector>
+
+#include "../../bytra/source/strategies/Strategies.h"
+#include "Backtester.h"
+#include "CandleSeries.h"
+#include "Optimizer.h"
+
+namespace {
+    void printResult(const Backtester::Result &result) {
+        std::cout << "  PnL             " << result.pnl() << " BTC (" << result.returnRatio() * 100 << " %)" << std::endl
+                  << "  Fees            " << result.fees << " BTC" << std::endl
+                  << "  Max drawdown    " << result.maxDrawdown * 100 << " %" << std::endl
+                  << "  Trades          " << result.trades << " (" << result.stopLosses << " stopped out)" << std::endl
+                  << "  Win rate        " << result.winRate() * 100 << " %" << std::endl
+                  << "  Average trade   " << result.averageTrade() << " BTC" << std::endl
+                  << "  Largest win     " << result.largestWin << " BTC" << std::endl
+                  << "  Largest loss    " << result.largestLoss << " BTC" << std::endl
+                  << "  Profit factor   " << result.profitFactor() << std::endl;
+    }
+
+    std::string describe(const StrategyParameters &parameters) {
+        std::string text;
+        for (auto &[name, value] : parameters) {
+            text += (text.empty() ? "" : " ") + name + "=" + fmt::format("{}", value);
+        }
+        return text;
+    }
+
+    void printRun(const Optimizer::Run &run) {
+        std::cout << "  " << describe(run.parameters) << ": " << run.result.returnRatio() * 100 << " %, drawdown "
+                  << run.result.maxDrawdown * 100 << " %, " << run.result.trades << " trades, win rate "
+                  << run.result.winRate() * 100 << " %, profit factor " << run.result.profitFactor() << std::endl;
+    }
+}  // namespace
+
+int main(int argc, char **argv) {
+    CLI::App app("BYTRA backtest");
+    std::string strategy;
+    app.add_option("-s,--strategy", strategy, "Name of the strategy")->required();
+    std::string candleFile;
+    app.add_option("-d,--data", candleFile, "CSV file with timestamp,open,high,low,close,volume lines")->required();
+    std::string configuration = "data/configuration.toml";
+    app.add_option("-c,--config", configuration, "Configuration file with the [backtest] table");
+    std::string tradesFile;
+    app.add_option("--trades", tradesFile, "CSV file every trade is written to");
+    std::vector<std::string> parameterOptions;
+    app.add_option("-p,--param", parameterOptions, "Strategy parameter as name=value, replaces [strategies.<name>]");
+    int optimize{0};
+    app.add_flag("-o,--optimize", optimize, "Search the parameter ranges in [optimize.<name>] instead");
+    size_t randomSamples = 0;
+    app.add_option("--random", randomSamples, "Backtest this many random parameter combinations, not the grid");
+    unsigned seed = 42;
+    app.add_option("--seed", seed, "Seed of the random search");
+    size_t inSample = 0;
+    app.add_option("--in-sample", inSample, "Walk-forward: candles the parameters are picked on, 0 disables it");
+    size_t outOfSample = 0;
+    app.add_option("--out-of-sample", outOfSample, "Walk-forward: candles the picked parameters are tested on");
+    size_t threads = 0;
+    app.add_option("--threads", threads, "Worker threads of the search, 0 for one per hardware thread");
+    std::string objective = "return";
+    app.add_option("--objective", objective, "What the search maximizes: return or return-over-drawdown");
+    size_t top = 10;
+    app.add_option("--top", top, "Best parameter combinations shown");
+
+    CLI11_PARSE(app, argc, argv)
+
+    toml::table tbl;
+    try {
+        tbl = toml::parse_file(configuration);
+    } catch (const toml::parse_error &err) {
+        std::cerr << "Parsing failed:\n" << err << std::endl;
+        return 1;
+    }
+
+    auto &validStrategies = strategyFactories();
+
+    if (validStrategies.find(strategy) == validStrategies.end()) {
+        std::cerr << "Invalid strategy: " << strategy << std::endl;
+        return 1;
+    }
+
+    // Parameters in [strategies.<name>] and on the command line replace the defaults of the strategy
+    StrategyParameters parameters;
+
+    if (auto *table = tbl["strategies"][strategy].as_table()) {
+        for (auto &[name, value] : *table) {
+            if (!value.value<double>()) {
+                std::cerr << "Strategy parameter " << name << " is not a number" << std::endl;
+                return 1;
+            }
+            parameters[name] = *value.value<double>();
+        }
+    }
+
+    for (auto &option : parameterOptions) {
+        auto separator = option.find('=');
+        if (separator == std::string::npos) {
+            std::cerr << "Expected name=value: " << option << std::endl;
+            return 1;
+        }
+        parameters[option.substr(0, separator)] = std::stod(option.substr(separator + 1));
+    }
+
+    // Searched parameters are added to the fixed ones
+    StrategyFactory factory = [base = parameters, &strategyFactory = validStrategies.at(strategy)](
+                                  const StrategyParameters &searched) {
+        StrategyParameters merged = base;
+        for (auto &[name, value] : searched) {
+            merged[name] = value;
+        }
+        return strategyFactory(merged);
+    };
+
+    Backtester::Settings settings;
+    settings.makerFee = tbl["backtest"]["makerFee"].value_or(settings.makerFee);
+    settings.takerFee = tbl["backtest"]["takerFee"].value_or(settings.takerFee);
+    settings.initialBalance = tbl["backtest"]["initialBalance"].value_or(settings.initialBalance);
+    settings.warmup = tbl["backtest"]["warmup"].value_or(settings.warmup);
+    settings.recordTrades = !tradesFile.empty();
+
+    auto loadStart = std::chrono::steady_clock::now();
+    CandleSeries series = CandleSeries::loadCsv(candleFile);
+    std::chrono::duration<double> loadTime = std::chrono::steady_clock::now() - loadStart;
+    std::cout << "Loaded " << series.size() << " candles in " << loadTime.count() << " s" << std::endl;
+
+    if (optimize) {
+        std::vector<ParameterRange> ranges;
+        auto *table = tbl["optimize"][strategy].as_table();
+
+        if (!table) {
+            std::cerr << "No parameter ranges in [optimize." << strategy << "]" << std::endl;
+            return 1;
+        }
+
+        for (auto &[name, value] : *table) {
+            auto *range = value.as_array();
+
+            if (!range || range->size() != 3 || !(*range)[0].value<double>() || !(*range)[1].value<double>()
+                || !(*range)[2].value<double>()) {
+                std::cerr << "Expected [min, max, step] for " << name << std::endl;
+                return 1;
+            }
+
+            ranges.push_back({name, *(*range)[0].value<double>(), *(*range)[1].value<double>(),
+                              *(*range)[2].value<double>()});
+        }
+
+        Optimizer::Settings search;
+        search.backtest = settings;
+        search.randomSamples = randomSamples;
+        search.seed = seed;
+        search.threads = threads;
+
+        if (objective == "return-over-drawdown") {
+            search.objective = Optimizer::Objective::ReturnOverDrawdown;
+        } else if (objective != "return") {
+            std::cerr << "Invalid objective: " << objective << std::endl;
+            return 1;
+        }
+
+        Optimizer optimizer(series, factory, ranges, search);
+        auto candidates = optimizer.candidates();
+        std::cout << "Searching " << candidates.size() << " parameter combinations on " << optimizer.threads()
+                  << " threads" << std::endl;
+
+        auto searchStart = std::chrono::steady_clock::now();
+        size_t backtests = 0;
+        size_t candles = 0;
+
+        if (inSample > 0) {
+            auto folds = optimizer.walkForward(candidates, inSample, outOfSample);
+            double compounded = 1;
+            long trades = 0;
+
+            for (auto &fold : folds) {
+                std::cout << "Fold " << fold.begin << " - " << fold.split << " - " << fold.end << ", best in-sample"
+                          << std::endl;
+                printRun(fold.inSample);
+                std::cout << "  out-of-sample: " << fold.outOfSample.returnRatio() * 100 << " %, drawdown "
+                          << fold.outOfSample.maxDrawdown * 100 << " %, " << fold.outOfSample.trades << " trades"
+                          << std::endl;
+
+                compounded *= 1 + fold.outOfSample.returnRatio();
+                trades += fold.outOfSample.trades;
+                backtests += candidates.size() + 1;
+                candles += candidates.size() * fold.inSample.result.candles + fold.outOfSample.candles;
+            }
+
+            std::cout << "Out-of-sample over " << folds.size() << " folds: " << (compounded - 1) * 100 << " %, "
+                      << trades << " trades" << std::endl;
+        } else {
+            auto runs = optimizer.sweep(candidates, 0, series.size());
+            std::cout << "Best of " << runs.size() << std::endl;
+
+            for (size_t i = 0; i < std::min(top, runs.size()); i++) {
+                printRun(runs[i]);
+            }
+
+            for (auto &run : runs) {
+                candles += run.result.candles;
+            }
+            backtests = runs.size();
+        }
+
+        std::chrono::duration<double> searchTime = std::chrono::steady_clock::now() - searchStart;
+        std::cout << backtests << " backtests in " << searchTime.count() << " s ("
+                  << candles / searchTime.count() / 1e6 << " M candles/s)" << std::endl;
+        return 0;
+    }
+
+    auto runStart = std::chrono::steady_clock::now();
+    Backtester::Result result = Backtester(factory({}), settings).run(series);
+    std::chrono::duration<double> runTime = std::chrono::steady_clock::now() - runStart;
+
+    std::cout << "Backtested " << result.candles << " candles in " << runTime.count() << " s ("
+              << series.size() / runTime.count() / 1e6 << " M candles/s)" << std::endl;
+    printResult(result);
+
+    if (!tradesFile.empty()) {
+        std::ofstream file(tradesFile);
+        file << "entry_time,exit_time,qty,entry_price,exit_price,pnl,stop_loss\n";
+
+        for (auto &trade : result.tradeLog) {
+            file << trade.entryTime << ',' << trade.exitTime << ',' << trade.qty << ',' << trade.entryPrice << ','
+                 << trade.exitPrice << ',' << trade.pnl << ',' << trade.stopLoss << '\n';
+        }
+
+        std::cout << "Trades written to " << tradesFile << std::endl;
+    }
+
+    return 0;
+}
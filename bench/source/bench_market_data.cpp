@@ -0,0 +1,106 @@
+#include "../bytra/source/AsyncLogger.cpp"
+#include "../bytra/source/MarketDataParser.cpp"
+#include "../bytra/source/OrderManager.cpp"
+#include "../bytra/source/Position.h"
+#include "benchmarks.h"
+
+void benchMarketData(ankerl::nanobench::Bench &bench) {
+    auto orderBookMessages = loadFixture("orderBookL2_25.BTCUSD.jsonl");
+    auto klineMessages = loadFixture("klineV2.1.BTCUSD.jsonl");
+
+    auto orderBook = std::make_shared<OrderBook>();
+    long candles = 0;
+    MarketDataParser parser(
+        orderBook, [&candles](const std::string_view &, const Candle &) { candles++; },
+        [](const std::string_view &) {});
+    parser.addTopic("orderBookL2_25.BTCUSD");
+    parser.addTopic("klineV2.1.BTCUSD");
+
+    // first message is the snapshot, the deltas are replayed on top of it
+    auto snapshot = reinterpret_cast<const uint8_t *>(orderBookMessages.front().data());
+    parser.parse(snapshot, orderBookMessages.front().size());
+
+    bench.batch(orderBookMessages.size() - 1).unit("msg").run("MarketDataParser orderBookL2_25 delta", [&] {
+        for (size_t i = 1; i < orderBookMessages.size(); i++) {
+            auto &msg = orderBookMessages[i];
+            parser.parse(reinterpret_cast<const uint8_t *>(msg.data()), msg.size());
+        }
+    });
+
+    bench.batch(1).unit("msg").run("MarketDataParser orderBookL2_25 snapshot", [&] {
+        parser.parse(snapshot, orderBookMessages.front().size());
+    });
+
+    bench.batch(klineMessages.size()).unit("msg").run("MarketDataParser klineV2", [&] {
+        for (auto &msg : klineMessages) {
+            parser.parse(reinterpret_cast<const uint8_t *>(msg.data()), msg.size());
+        }
+    });
+    ankerl::nanobench::doNotOptimizeAway(candles);
+
+    // Reference: building the DOM tree alone, before any field of the message is looked up
+    simdjson::dom::parser domParser;
+
+    bench.batch(orderBookMessages.size() - 1).unit("msg").run("dom::parser orderBookL2_25 delta (parse only)", [&] {
+        for (size_t i = 1; i < orderBookMessages.size(); i++) {
+            simdjson::dom::element doc = domParser.parse(orderBookMessages[i]);
+            ankerl::nanobench::doNotOptimizeAway(doc);
+        }
+    });
+
+    bench.batch(klineMessages.size()).unit("msg").run("dom::parser klineV2 (parse only)", [&] {
+        for (auto &msg : klineMessages) {
+            simdjson::dom::element doc = domParser.parse(msg);
+            ankerl::nanobench::doNotOptimizeAway(doc);
+        }
+    });
+
+    // Private topics go through the DOM parser, the handlers below do what Bybit::parseOrderMsg and
+    // Bybit::parsePositionMsg do with a message
+    auto orderMessages = loadFixture("order.jsonl");
+    auto positionMessages = loadFixture("position.jsonl");
+
+    OrderManager orderManager("bytra-1603101600000-");
+    for (int i = 0; i < 20; i++) {
+        orderManager.add(Order(11720.5, 100, 5.0));
+    }
+
+    // Orders stay in the manager, the replayed reports of finished orders are looked up and ignored
+    bench.batch(orderMessages.size()).unit("msg").run("DOM order + OrderManager::onExecutionReport", [&] {
+        for (auto &msg : orderMessages) {
+            simdjson::dom::element response = domParser.parse(msg);
+
+            for (simdjson::dom::object item : response["data"]) {
+                std::string_view linkId;
+                std::string_view orderStatus = item["order_status"];
+                int64_t filledQty = 0;
+
+                if (item["order_link_id"].get(linkId) || item["cum_exec_qty"].get(filledQty)) {
+                    continue;
+                }
+
+                ankerl::nanobench::doNotOptimizeAway(orderManager.onExecutionReport(linkId, orderStatus, filledQty));
+            }
+        }
+    });
+
+    Position position;
+
+    bench.batch(positionMessages.size()).unit("msg").run("DOM position + Position::update", [&] {
+        for (auto &msg : positionMessages) {
+            simdjson::dom::element response = domParser.parse(msg);
+
+            for (simdjson::dom::object item : response["data"]) {
+                std::string_view entryPrice = item["entry_price"];
+                std::string_view side = item["side"];
+                long qty = (long)item["size"];
+                if (side == "Sell") {
+                    qty = -qty;
+                }
+
+                position.update(qty, std::strtod(entryPrice.data(), nullptr));
+            }
+        }
+    });
+    ankerl::nanobench::doNotOptimizeAway(position.qty);
+}
@@ -0,0 +1,89 @@
+#include "../bytra/source/OrderBook.h"
+#include "benchmarks.h"
+
+namespace {
+    struct BookChange {
+        char action;  // 'd'elete, 'u'pdate or 'i'nsert
+        bool buy;
+        long id;
+        double price;
+        long size;
+    };
+
+    // Decodes the recorded messages up front, so only the order book itself is measured
+    std::vector<BookChange> decodeChanges(const simdjson::padded_string &msg, simdjson::dom::parser &parser) {
+        std::vector<BookChange> changes;
+        simdjson::dom::element data = parser.parse(msg)["data"];
+        auto entries = data.is_array() ? std::vector<std::pair<char, simdjson::dom::array>>{{'i', data}}
+                                       : std::vector<std::pair<char, simdjson::dom::array>>{
+                                           {'d', data["delete"]}, {'u', data["update"]}, {'i', data["insert"]}};
+
+        for (auto &[action, array] : entries) {
+            for (simdjson::dom::object entry : array) {
+                std::string_view side = entry["side"];
+                double price = 0;
+                int64_t size = 0;
+
+                if (std::string_view str; !entry["price"].get(str)) {
+                    price = std::strtod(str.data(), nullptr);
+                }
+                entry["size"].get(size);
+
+                changes.push_back({action, side == "Buy", int64_t(entry["id"]), price, size});
+            }
+        }
+
+        return changes;
+    }
+
+    void apply(OrderBook &book, const BookChange &change) {
+        switch (change.action) {
+            case 'd':
+                change.buy ? book.removeBidEntry(change.id) : book.removeAskEntry(change.id);
+                break;
+            case 'u':
+                change.buy ? book.updateBidEntry(change.id, change.size) : book.updateAskEntry(change.id, change.size);
+                break;
+            default:
+                change.buy ? book.addBidEntry(change.id, OrderBookEntry(change.price, change.size))
+                           : book.addAskEntry(change.id, OrderBookEntry(change.price, change.size));
+        }
+    }
+}  // namespace
+
+void benchOrderBook(ankerl::nanobench::Bench &bench) {
+    auto messages = loadFixture("orderBookL2_25.BTCUSD.jsonl");
+    simdjson::dom::parser parser;
+
+    auto snapshot = decodeChanges(messages.front(), parser);
+    std::vector<BookChange> deltas;
+
+    for (size_t i = 1; i < messages.size(); i++) {
+        auto changes = decodeChanges(messages[i], parser);
+        deltas.insert(deltas.end(), changes.begin(), changes.end());
+    }
+
+    OrderBook book;
+
+    for (auto &change : snapshot) {
+        apply(book, change);
+    }
+
+    bench.batch(deltas.size()).unit("change").run("OrderBook apply delta", [&] {
+        for (auto &change : deltas) {
+            apply(book, change);
+        }
+    });
+
+    // Best prices after every change, like a trading pass after every frame
+    bench.batch(deltas.size()).unit("change").run("OrderBook apply delta + best prices", [&] {
+        for (auto &change : deltas) {
+            apply(book, change);
+            ankerl::nanobench::doNotOptimizeAway(book.askPrice() - book.bidPrice());
+        }
+    });
+
+    bench.batch(1).unit("query").run("OrderBook best prices (unchanged book)", [&] {
+        ankerl::nanobench::doNotOptimizeAway(book.askPrice() - book.bidPrice());
+    });
+}
@@ -0,0 +1,30 @@
+#include "../bytra/source/RequestBuilder.cpp"
+#include "benchmarks.h"
+
+namespace {
+    // Same fields as the limit order Bybit sends
+    constexpr RequestTemplate<11> limitOrderRequest({"api_key", "order_link_id", "order_type", "price", "qty",
+                                                     "recv_window", "reduce_only", "side", "symbol", "time_in_force",
+                                                     "timestamp"});
+}  // namespace
+
+void benchRequestBuilder(ankerl::nanobench::Bench &bench) {
+    const std::string apiKey = "B2Rou0PLPpGqcU0Vu2";
+    const std::string linkId = "bytra-1603101600000-17";
+    HmacSigner signer("Y2hhbmdlbWVjaGFuZ2VtZWNoYW5nZW1l");
+    RequestBuilder builder;
+    long timestamp = 1603101600000;
+
+    bench.batch(1).unit("request").run("RequestBuilder::build limit order (signed)", [&] {
+        ankerl::nanobench::doNotOptimizeAway(
+            builder.build(limitOrderRequest, signer, apiKey, linkId, "Limit", Decimal{11720.5}, 100L, 1000L,
+                          std::optional<std::string_view>(), "Buy", "BTCUSD", "PostOnly", timestamp++));
+    });
+
+    auto prepared = builder.prepare(limitOrderRequest, apiKey, Deferred{}, "Limit", Deferred{}, 100L, 1000L,
+                                    std::optional<std::string_view>(), "Buy", "BTCUSD", "PostOnly", Deferred{});
+
+    bench.batch(1).unit("request").run("RequestBuilder::build prepared limit order (signed)", [&] {
+        ankerl::nanobench::doNotOptimizeAway(builder.build(prepared, signer, linkId, Decimal{11720.5}, timestamp++));
+    });
+}
@@ -0,0 +1,104 @@
+#include <cmath>
+
+#include "../bytra/source/strategies/Ema.cpp"
+#include "../bytra/source/strategies/Rsi.cpp"
+#include "benchmarks.h"
+
+namespace {
+    using CandleMap = std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>>;
+
+    // Deterministic random walk of one minute candles, the same series on every run
+    std::vector<Candle> makeCandles(const size_t &count) {
+        std::vector<Candle> candles;
+        candles.reserve(count);
+        double close = 11700;
+        unsigned int seed = 42;
+
+        for (size_t i = 0; i < count; i++) {
+            seed = seed * 1103515245 + 12345;
+            double open = close;
+            close += (double((seed >> 16) & 0x7fff) / 0x7fff - 0.5) * 20;
+            candles.push_back({open, std::max(open, close) + 2, std::min(open, close) - 2, close, 1000,
+                               1603101600 + long(i) * 60});
+        }
+
+        return candles;
+    }
+}  // namespace
+
+void benchStrategies(ankerl::nanobench::Bench &bench) {
+    const TimeFrame tf("1", 1000);
+    auto series = makeCandles(2 * tf.amount);
+
+    CandleMap candles;
+    for (size_t i = 0; i < size_t(tf.amount); i++) {
+        candles[tf].push_back(std::make_shared<Candle>(series[i]));
+    }
+
+    Rsi rsi;
+    Ema ema;
+
+    // Full recompute over the whole window, what the strategies did on every closed candle
+    bench.batch(1).unit("candle").run("Rsi::calculateRSI (1000 candles)", [&] {
+        ankerl::nanobench::doNotOptimizeAway(rsi.calculateRSI(candles));
+    });
+
+    bench.batch(1).unit("candle").run("Ema::calculateEMA 20 + 50 (1000 candles)", [&] {
+        ankerl::nanobench::doNotOptimizeAway(ema.calculateEMA(candles, 20));
+        ankerl::nanobench::doNotOptimizeAway(ema.calculateEMA(candles, 50));
+    });
+
+    // Incremental updates, one closed candle at a time
+    WilderRsi wilderRsi(10);
+    ExponentialMovingAverage fastEma(20);
+    ExponentialMovingAverage slowEma(50);
+    size_t next = 0;
+
+    bench.batch(1).unit("candle").run("WilderRsi::update + closeFor", [&] {
+        wilderRsi.update(series[next++ % series.size()].close);
+        ankerl::nanobench::doNotOptimizeAway(wilderRsi.closeFor(30));
+    });
+
+    bench.batch(1).unit("candle").run("ExponentialMovingAverage::update 20 + 50", [&] {
+        double close = series[next++ % series.size()].close;
+        fastEma.update(close);
+        slowEma.update(close);
+        ankerl::nanobench::doNotOptimizeAway(fastEma.value() - slowEma.value());
+    });
+
+    TriggerLevels levels;
+    size_t closed = tf.amount;
+
+    bench.batch(1).unit("candle").run("Rsi::updateTriggerLevels (1 new candle)", [&] {
+        auto candle = series[closed % series.size()];
+        candle.timestamp = 1603101600 + long(closed++) * 60;
+        candles[tf].push_back(std::make_shared<Candle>(candle));
+        trimCandles(candles[tf], tf.amount);
+        ankerl::nanobench::doNotOptimizeAway(rsi.updateTriggerLevels(candles, levels));
+    });
+}
+
+void benchCandles(ankerl::nanobench::Bench &bench) {
+    const TimeFrame tf("1", 1000);
+    auto series = makeCandles(4 * tf.amount);
+    std::vector<std::shared_ptr<Candle>> candles;
+    size_t next = 0;
+
+    // Append on every closed candle and trim once four times the window piled up, the cost of a trim is
+    // spread over the appends in between
+    bench.batch(1).unit("candle").run("Candle append + trimCandles (erase)", [&] {
+        candles.push_back(std::make_shared<Candle>(series[next++ % series.size()]));
+        trimCandles(candles, tf.amount);
+    });
+
+    candles.clear();
+
+    bench.batch(1).unit("candle").run("Candle append + trim (copy into new vector)", [&] {
+        candles.push_back(std::make_shared<Candle>(series[next++ % series.size()]));
+
+        if (candles.size() >= size_t(tf.amount * 4)) {
+            std::vector<std::shared_ptr<Candle>> trimmed(candles.end() - tf.amount, candles.end());
+            candles = trimmed;
+        }
+    });
+}
@@ -0,0 +1,48 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_BENCHMARKS_H
+#define BYTRA_BENCHMARKS_H
+
+#include <simdjson.h>
+
+#include <fstream>
+#include <nanobench.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Recorded websocket messages, one message per line
+inline std::vector<simdjson::padded_string> loadFixture(const std::string &name) {
+    std::ifstream file(std::string(BYTRA_FIXTURES_DIR) + "/" + name);
+
+    if (!file) {
+        throw std::runtime_error("Missing fixture: " + name);
+    }
+
+    std::vector<simdjson::padded_string> messages;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (!line.empty()) {
+            messages.emplace_back(line);
+        }
+    }
+
+    return messages;
+}
+
+void benchMarketData(ankerl::nanobench::Bench &bench);
+
+void benchHmacSigner(ankerl::nanobench::Bench &bench);
+
+void benchOrderBook(ankerl::nanobench::Bench &bench);
+
+void benchStrategies(ankerl::nanobench::Bench &bench);
+
+void benchCandles(ankerl::nanobench::Bench &bench);
+
+void benchRequestBuilder(ankerl::nanobench::Bench &bench);
+
+#endif  // BYTRA_BENCHMARKS_H
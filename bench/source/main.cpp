@@ -0,0 +1,27 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+
+#include <fstream>
+#include <iostream>
+#include <nanobench.h>
+
+#include "benchmarks.h"
+
+int main(int argc, char **argv) {
+    ankerl::nanobench::Bench bench;
+    bench.title("BYTRA").warmup(100).relative(false);
+
+    benchMarketData(bench);
+    benchHmacSigner(bench);
+    benchOrderBook(bench);
+    benchStrategies(bench);
+    benchCandles(bench);
+    benchRequestBuilder(bench);
+
+    // Machine readable results, so runs can be compared between builds
+    std::string output = argc > 1 ? argv[1] : "bench_results.json";
+    std::ofstream file(output);
+    bench.render(ankerl::nanobench::templates::json(), file);
+    std::cout << "Results written to " << output << std::endl;
+
+    return 0;
+}
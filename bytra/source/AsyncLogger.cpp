@@ -0,0 +1,66 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "AsyncLogger.h"
+
+#include <chrono>
+#include <stdexcept>
+
+std::atomic<AsyncLogger *> AsyncLogger::instance{nullptr};
+
+AsyncLogger::AsyncLogger() {
+    queue = std::make_unique<MpmcQueue<LogRecord, queueCapacity>>();
+
+    AsyncLogger *expected = nullptr;
+    if (!instance.compare_exchange_strong(expected, this)) {
+        throw std::logic_error("Only one AsyncLogger can run at a time.");
+    }
+
+    writer = std::thread(&AsyncLogger::run, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+    // Log calls made from now on are written right away, the writer empties the queue before it stops
+    instance = nullptr;
+    running = false;
+
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    spdlog::default_logger_raw()->flush();
+}
+
+void AsyncLogger::write(const LogRecord &record) {
+    try {
+        spdlog::default_logger_raw()->log(record.time, spdlog::source_loc{}, record.level, record.format(record));
+    } catch (const std::exception &e) {
+        spdlog::default_logger_raw()->log(spdlog::level::err, "AsyncLogger - failed to format \"{}\": {}",
+                                          record.formatString, e.what());
+    }
+}
+
+void AsyncLogger::run() {
+    LogRecord record;
+
+    for (;;) {
+        bool stopping = !running;
+
+        while (queue->pop(record)) {
+            write(record);
+        }
+
+        if (uint64_t lost = dropped.exchange(0, std::memory_order_relaxed)) {
+            spdlog::default_logger_raw()->log(spdlog::level::warn, "AsyncLogger - queue full, dropped {} records",
+                                              lost);
+        }
+
+        if (stopping) {
+            return;
+        }
+
+        // Log records are not latency sensitive, an idle writer sleeps instead of spinning
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
@@ -0,0 +1,199 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_ASYNCLOGGER_H
+#define BYTRA_ASYNCLOGGER_H
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#include "MpmcQueue.h"
+
+// Log statements below this level are compiled out, it defaults to everything from debug up
+#ifndef BYTRA_LOG_ACTIVE_LEVEL
+#define BYTRA_LOG_ACTIVE_LEVEL SPDLOG_LEVEL_DEBUG
+#endif
+
+#if BYTRA_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define BYTRA_LOG_DEBUG(...) AsyncLogger::log(spdlog::level::debug, __VA_ARGS__)
+#else
+#define BYTRA_LOG_DEBUG(...) (void)0
+#endif
+
+#if BYTRA_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define BYTRA_LOG_INFO(...) AsyncLogger::log(spdlog::level::info, __VA_ARGS__)
+#else
+#define BYTRA_LOG_INFO(...) (void)0
+#endif
+
+#if BYTRA_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define BYTRA_LOG_WARN(...) AsyncLogger::log(spdlog::level::warn, __VA_ARGS__)
+#else
+#define BYTRA_LOG_WARN(...) (void)0
+#endif
+
+#if BYTRA_LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define BYTRA_LOG_ERROR(...) AsyncLogger::log(spdlog::level::err, __VA_ARGS__)
+#else
+#define BYTRA_LOG_ERROR(...) (void)0
+#endif
+
+/** Log statement captured as its format string and its arguments in binary form
+ * Strings are copied into the record and cut off when they don't fit, everything else is copied as is.
+ * The record knows how to decode and format its own arguments.
+ * */
+struct LogRecord {
+    static constexpr size_t payloadSize = 448;
+
+    std::string (*format)(const LogRecord &) = nullptr;
+    const char *formatString = nullptr;
+    spdlog::level::level_enum level = spdlog::level::info;
+    spdlog::log_clock::time_point time;
+    std::array<char, payloadSize> payload;
+};
+
+namespace logging {
+    // Arguments are stored as their decayed type, strings of any kind as a length followed by the characters
+    template <typename T> struct Stored {
+        using type = std::conditional_t<std::is_convertible_v<const T &, std::string_view>, std::string_view, T>;
+    };
+
+    template <typename T> using StoredType = typename Stored<std::decay_t<T>>::type;
+
+    template <typename T> constexpr size_t fixedSize() {
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            return sizeof(uint16_t);
+        } else {
+            return sizeof(T);
+        }
+    }
+
+    class PayloadWriter {
+      private:
+        char *pos;
+        size_t stringBudget;  // bytes left for string characters
+
+      public:
+        PayloadWriter(char *payload, const size_t &stringBudget) : pos(payload), stringBudget(stringBudget) {}
+
+        template <typename T> void write(const T &value) {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                auto length = static_cast<uint16_t>(std::min(value.size(), stringBudget));
+                stringBudget -= length;
+                std::memcpy(pos, &length, sizeof(length));
+                std::memcpy(pos + sizeof(length), value.data(), length);
+                pos += sizeof(length) + length;
+            } else {
+                std::memcpy(pos, &value, sizeof(T));
+                pos += sizeof(T);
+            }
+        }
+    };
+
+    class PayloadReader {
+      private:
+        const char *pos;
+
+      public:
+        explicit PayloadReader(const char *payload) : pos(payload) {}
+
+        template <typename T> T read() {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                uint16_t length;
+                std::memcpy(&length, pos, sizeof(length));
+                std::string_view value(pos + sizeof(length), length);
+                pos += sizeof(length) + length;
+                return value;
+            } else {
+                T value;
+                std::memcpy(&value, pos, sizeof(T));
+                pos += sizeof(T);
+                return value;
+            }
+        }
+    };
+
+    template <typename... Args> std::string formatRecord(const LogRecord &record) {
+        PayloadReader reader(record.payload.data());
+        // Braced initialization reads the arguments in order
+        std::tuple<Args...> args{reader.read<Args>()...};
+
+        return std::apply(
+            [&record](auto &...values) { return fmt::vformat(record.formatString, fmt::make_format_args(values...)); },
+            args);
+    }
+}  // namespace logging
+
+/** Logging off the hot path
+ * A log call only copies its arguments into a record on a preallocated lock-free queue, the writer thread
+ * formats the records and passes them to the spdlog logger. When the queue is full the record is dropped and
+ * counted, logging never blocks. Until an AsyncLogger is started log calls are formatted and logged right away.
+ * */
+class AsyncLogger {
+  private:
+    static constexpr size_t queueCapacity = 2048;
+
+    static std::atomic<AsyncLogger *> instance;
+
+    std::unique_ptr<MpmcQueue<LogRecord, queueCapacity>> queue;
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> dropped{0};
+    std::thread writer;
+
+    static void write(const LogRecord &record);
+
+    void run();
+
+  public:
+    AsyncLogger();
+
+    ~AsyncLogger();
+
+    AsyncLogger(const AsyncLogger &) = delete;
+
+    AsyncLogger &operator=(const AsyncLogger &) = delete;
+
+    // format has to outlive the logger, pass a string literal
+    template <typename... Args>
+    static void log(const spdlog::level::level_enum &level, const char *format, const Args &...args) {
+        if (!spdlog::default_logger_raw()->should_log(level)) {
+            return;
+        }
+
+        static_assert((std::is_trivially_copyable_v<logging::StoredType<Args>> && ...),
+                      "Log arguments have to be strings or trivially copyable");
+        constexpr size_t fixed = (logging::fixedSize<logging::StoredType<Args>>() + ... + 0);
+        static_assert(fixed <= LogRecord::payloadSize, "Too many log arguments");
+
+        LogRecord record;
+        record.format = &logging::formatRecord<logging::StoredType<Args>...>;
+        record.formatString = format;
+        record.level = level;
+        record.time = spdlog::log_clock::now();
+
+        logging::PayloadWriter writer(record.payload.data(), LogRecord::payloadSize - fixed);
+        (writer.write(logging::StoredType<Args>(args)), ...);
+
+        AsyncLogger *logger = instance.load(std::memory_order_acquire);
+
+        if (logger == nullptr) {
+            write(record);
+        } else if (!logger->queue->push(record)) {
+            logger->dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif  // BYTRA_ASYNCLOGGER_H
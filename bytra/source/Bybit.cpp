@@ -6,16 +6,17 @@
 
 #include <cpr/cpr.h>
 #include <simdjson/simdjson.h>
-#include <spdlog/spdlog.h>
 
 #include <boost/asio/connect.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/beast/websocket/ssl.hpp>
 
-#include "Encryption.h"
+#include "AsyncLogger.h"
+#include "BybitRequests.h"
 #include "TerminalColors.h"
 
 namespace beast = boost::beast;          // from <boost/beast.hpp>
@@ -27,52 +28,211 @@ using tcp = boost::asio::ip::tcp;        // from <boost/asio/ip/tcp.hpp>
 using namespace simdjson;
 using namespace std::chrono;
 
+// Strings in a parsed document are null terminated, so they can be converted in place
+static double toDouble(std::string_view str) { return std::strtod(str.data(), nullptr); }
+
+static const char *apiErrorsName = "bytra_rest_api_errors_total";
+static const char *apiErrorsHelp = "REST responses with a non-zero ret_code";
+
+static std::string apiErrorsLabel(const std::string &endpoint, const int &retCode) {
+    return "endpoint=\"" + endpoint + "\",ret_code=\"" + std::to_string(retCode) + "\"";
+}
+
+// One parser per thread, its internal buffers are reused for every response
+static dom::element parseApiResponse(const cpr::Response &r) {
+    thread_local dom::parser parser;
+    return parser.parse(r.text);
+}
+
+// One builder per thread, private requests are sent from the market data thread and the order executor
+static RequestBuilder &requestBuilder() {
+    thread_local RequestBuilder builder;
+    return builder;
+}
+
+// Private endpoints report the rate limit of the endpoint with every response
+static void readRateLimit(const dom::element &response, OrderReport &report) {
+    int64_t status;
+    int64_t resetMs;
+
+    if (!response["rate_limit_status"].get(status) && !response["rate_limit_reset_ms"].get(resetMs)) {
+        report.rateLimitStatus = status;
+        report.rateLimitResetMs = resetMs;
+    }
+}
+
+namespace {
+    const std::string klineEndpoint = "/v2/public/kline/list";
+    const std::string positionListEndpoint = "/v2/private/position/list";
+    const std::string cancelAllEndpoint = "/v2/private/order/cancelAll";
+    const std::string createOrderEndpoint = "/v2/private/order/create";
+    const std::string replaceOrderEndpoint = "/open-api/order/replace";
+    const std::string cancelOrderEndpoint = "/v2/private/order/cancel";
+    const std::string tradingStopEndpoint = "/v2/private/position/trading-stop";
+
+    const std::string &orderEndpoint(const OrderRequestType &type) {
+        switch (type) {
+            case OrderRequestType::Market:
+            case OrderRequestType::Limit:
+                return createOrderEndpoint;
+            case OrderRequestType::Amend:
+                return replaceOrderEndpoint;
+            case OrderRequestType::Cancel:
+                return cancelOrderEndpoint;
+            case OrderRequestType::TradingStop:
+                return tradingStopEndpoint;
+        }
+
+        return createOrderEndpoint;
+    }
+}  // namespace
+
 Bybit::Bybit(std::string &baseUrl, std::string &apiKey, std::string &apiSecret, std::string &websocketHost,
              std::string &websocketTarget, const std::shared_ptr<Strategy> &strategy) {
     this->baseUrl = baseUrl;
     this->apiKey = apiKey;
-    this->apiSecret = apiSecret;
+    this->signer = std::make_unique<HmacSigner>(apiSecret);
     this->websocketHost = websocketHost;
     this->websocketTarget = websocketTarget;
     this->strategy = strategy;
 
+    // One session for the order executor, one for calls on the market data thread and a spare
+    httpSessions = std::make_unique<HttpSessionPool>(baseUrl, "/v2/public/time", 3);
+    httpSessions->preconnect();
+    clockSync = std::make_unique<ClockSync>(*httpSessions, "/v2/public/time");
+    rateLimiter = std::make_unique<RateLimiter>([this] { return clockSync->now(); });
+    std::vector<std::string> endpoints = {klineEndpoint,        positionListEndpoint, cancelAllEndpoint,
+                                          createOrderEndpoint,  replaceOrderEndpoint, cancelOrderEndpoint,
+                                          tradingStopEndpoint};
+    latency = std::make_unique<LatencyStats>(endpoints);
+    registerMetrics(endpoints);
+
+    // order_link_id has to be unique per account, the start time keeps ids of different sessions apart
+    orderManager = std::make_unique<OrderManager>(
+        "bytra-" + std::to_string(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count()) + "-");
+
     for (const auto &tf : strategy->getTimeframes()) {
         auto it = std::find(allowedTimeframes.begin(), allowedTimeframes.end(), tf.first);
 
         if (it == allowedTimeframes.end()) {
-            spdlog::error("Bybit::Bybit(..) - invalid timeframe");
+            BYTRA_LOG_ERROR("Bybit::Bybit(..) - invalid timeframe");
             throw std::invalid_argument("Invalid timeframe: " + tf.first + " in strategy " + strategy->getName());
         }
         candles[TimeFrame(tf.first, tf.second)] = {};
     }
 
+    auto signalTimeframe = candles.find(TimeFrame(strategy->getTimeframes()[0].first, 0));
+    signalCandles = &signalTimeframe->second;
+    signalInterval = minutes(signalTimeframe->first.ticks);
+
     loadCandles();
 
     position = std::make_shared<Position>();
     position->stopLossPercentage = strategy->getStopLossPercentage();
     orderBook = std::make_shared<OrderBook>();
+    marketDataParser = std::make_unique<MarketDataParser>(
+        orderBook, [this](const std::string_view &interval, const Candle &candle) { addCandle(interval, candle); },
+        [this](const std::string_view &error) {
+            BYTRA_LOG_ERROR("[WebSocket] Invalid order book message, resubscribing: {}", error);
+            syncOrderBook();
+        });
+
+    // Order book snapshots are the largest messages, this leaves plenty of room so the parser never reallocates
+    if (auto error = websocketParser.allocate(1 << 16)) {
+        throw std::runtime_error(error_message(error));
+    }
 }
 
-cpr::Response Bybit::ApiGet(const cpr::Parameters &parameters, const std::string &endpoint) {
-    spdlog::debug("[HTTP-GET] " + baseUrl + endpoint + " - " + parameters.content);
-    cpr::Response r = cpr::Get(cpr::Url{baseUrl + endpoint}, parameters);
-    spdlog::debug("[RESP-" + std::to_string(r.status_code) + "]");
+void Bybit::checkApiResponse(const std::string &endpoint, const cpr::Response &r,
+                             const steady_clock::time_point &start) {
+    latency->record(endpoint, start);
+    // Responses without a rate limit in their body, like errors, can still carry it in the headers
+    rateLimiter->update(endpoint, r.header);
+
+    auto restMetrics = restEndpointMetrics.find(endpoint);
+
+    if (restMetrics != restEndpointMetrics.end()) {
+        restMetrics->second.requests->increment();
+    }
+
+    if (r.status_code == 403 || r.status_code == 429) {
+        BYTRA_LOG_ERROR("Bybit - rate limit exceeded for {}", endpoint);
+
+        if (restMetrics != restEndpointMetrics.end()) {
+            restMetrics->second.rateLimited->increment();
+        }
+        throw std::runtime_error("Rate limit exceeded.");
+    }
 
     if (r.status_code != 200) {
+        if (restMetrics != restEndpointMetrics.end()) {
+            restMetrics->second.errors->increment();
+        }
         throw std::runtime_error("Bad API response.");
     }
+}
+
+int Bybit::checkPrivateResponse(const std::string &endpoint, const dom::element &response) {
+    // The v2 endpoints report their rate limit in the body, it replaces whatever the headers said
+    rateLimiter->update(endpoint, response);
+
+    int retCode = response["ret_code"].get_int64();
+
+    if (retCode == 0) {
+        return retCode;
+    }
+
+    // Routine codes are counted without a lookup in the registry, which contends with rendering the metrics
+    if (auto restMetrics = restEndpointMetrics.find(endpoint); restMetrics != restEndpointMetrics.end()) {
+        if (auto apiError = restMetrics->second.apiErrors.find(retCode);
+            apiError != restMetrics->second.apiErrors.end()) {
+            apiError->second->increment();
+            return retCode;
+        }
+    }
+
+    // Other codes are only known once they occur, their series is registered then
+    metrics->counter(apiErrorsName, apiErrorsHelp, apiErrorsLabel(endpoint, retCode)).increment();
+
+    return retCode;
+}
+
+cpr::Response Bybit::ApiGet(const cpr::Parameters &parameters, const std::string &endpoint) {
+    BYTRA_LOG_DEBUG("[HTTP-GET] {}{} - {}", baseUrl, endpoint, parameters.content);
+    auto start = steady_clock::now();
+    cpr::Response r = httpSessions->get(endpoint, parameters);
+    BYTRA_LOG_DEBUG("[RESP-{}]", r.status_code);
+    checkApiResponse(endpoint, r, start);
 
     return r;
 }
 
 cpr::Response Bybit::ApiPost(const cpr::Payload &payload, const std::string &endpoint) {
-    spdlog::debug("[HTTP-POST] " + baseUrl + endpoint + " - " + payload.content);
-    cpr::Response r = cpr::Post(cpr::Url{baseUrl + endpoint}, payload);
-    spdlog::debug("[RESP-" + std::to_string(r.status_code) + "] " + r.text);
+    BYTRA_LOG_DEBUG("[HTTP-POST] {}{} - {}", baseUrl, endpoint, payload.content);
+    auto start = steady_clock::now();
+    cpr::Response r = httpSessions->post(endpoint, payload);
+    BYTRA_LOG_DEBUG("[RESP-{}] {}", r.status_code, r.text);
+    checkApiResponse(endpoint, r, start);
 
-    if (r.status_code != 200) {
-        throw std::runtime_error("Bad API response.");
-    }
+    return r;
+}
+
+cpr::Response Bybit::ApiGet(const std::string_view &query, const std::string &endpoint) {
+    BYTRA_LOG_DEBUG("[HTTP-GET] {}{} - {}", baseUrl, endpoint, query);
+    auto start = steady_clock::now();
+    cpr::Response r = httpSessions->get(endpoint, query);
+    BYTRA_LOG_DEBUG("[RESP-{}]", r.status_code);
+    checkApiResponse(endpoint, r, start);
+
+    return r;
+}
+
+cpr::Response Bybit::ApiPost(const std::string_view &body, const std::string &endpoint) {
+    BYTRA_LOG_DEBUG("[HTTP-POST] {}{} - {}", baseUrl, endpoint, body);
+    auto start = steady_clock::now();
+    cpr::Response r = httpSessions->post(endpoint, body);
+    BYTRA_LOG_DEBUG("[RESP-{}] {}", r.status_code, r.text);
+    checkApiResponse(endpoint, r, start);
 
     return r;
 }
@@ -86,22 +246,20 @@ void Bybit::loadCandles() {
         int batch_size = 200;
         int batches = std::ceil(float(tf.amount + 1) / float(batch_size));
 
-        std::string endpoint = "/v2/public/kline/list";
-
         for (int i = 0; i < batches; i++) {
             auto parameters = cpr::Parameters{
                 {"symbol", strategy->getSymbol()}, {"interval", tf.symbol}, {"from", std::to_string(from)}};
 
-            cpr::Response r = ApiGet(parameters, endpoint);
-            dom::parser parser;
-            dom::element response = parser.parse(r.text);
+            rateLimiter->acquire(klineEndpoint, RequestPriority::Backfill);
+            cpr::Response r = ApiGet(parameters, klineEndpoint);
+            dom::element response = parseApiResponse(r);
 
             for (dom::object item : response["result"]) {
-                double open = std::stod((std::string)item["open"]);
-                double high = std::stod((std::string)item["high"]);
-                double low = std::stod((std::string)item["low"]);
-                double close = std::stod((std::string)item["close"]);
-                double volume = std::stod((std::string)item["volume"]);
+                double open = toDouble(item["open"]);
+                double high = toDouble(item["high"]);
+                double low = toDouble(item["low"]);
+                double close = toDouble(item["close"]);
+                double volume = toDouble(item["volume"]);
                 long timestamp = (long)item["open_time"];
                 auto candle = std::make_shared<Candle>(Candle{open, high, low, close, volume, timestamp});
 
@@ -115,77 +273,96 @@ void Bybit::loadCandles() {
 }
 
 void Bybit::loadPosition() {
-    std::string expires
-        = std::to_string(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + 1000);
-
-    std::string endpoint = "/v2/private/position/list";
-    // pairs have to be in alphabetic order
-    auto parameters = cpr::Parameters{{"api_key", apiKey}, {"symbol", strategy->getSymbol()}, {"timestamp", expires}};
+    auto query = requestBuilder().build(positionListRequest, *signer, apiKey, recvWindow.count(),
+                                        strategy->getSymbol(), clockSync->timestamp());
 
-    cpr::CurlHolder holder;
-    parameters.AddParameter({"sign", HmacEncode(parameters.content, apiSecret)}, holder);
+    rateLimiter->acquire(positionListEndpoint, RequestPriority::Critical);
+    cpr::Response r = ApiGet(query, positionListEndpoint);
+    dom::element response = parseApiResponse(r);
 
-    cpr::Response r = ApiGet(parameters, endpoint);
-    dom::parser parser;
-    dom::element response = parser.parse(r.text);
-
-    int retCode = response["ret_code"].get_int64();
+    int retCode = checkPrivateResponse(positionListEndpoint, response);
 
     if (retCode != 0) {
-        spdlog::error("Bybit::getPositionApi - bad response - " + (std::string)response["ret_msg"]);
+        BYTRA_LOG_ERROR("Bybit::getPositionApi - bad response - {}", std::string_view(response["ret_msg"]));
         throw std::runtime_error("Bad API response.");
     }
 
-    double entryPrice = std::stod((std::string)response["result"]["entry_price"]);
-    std::string side = (std::string)response["result"]["side"];
+    double entryPrice = toDouble(response["result"]["entry_price"]);
+    std::string_view side = response["result"]["side"];
     long qty = (long)response["result"]["size"];
     if (side == "Sell") {
         qty = -qty;
     }
 
     position->update(qty, entryPrice);
+    pendingEvents |= PositionChanged;
 }
 
 void Bybit::cancelAllActiveOrders() {
-    std::string expires
-        = std::to_string(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + 1000);
-
-    std::string endpoint = "/v2/private/order/cancelAll";
-    // pairs have to be in alphabetic order
-    cpr::Payload payload = cpr::Payload{{"api_key", apiKey}, {"symbol", strategy->getSymbol()}, {"timestamp", expires}};
+    auto body = requestBuilder().build(cancelAllRequest, *signer, apiKey, recvWindow.count(), strategy->getSymbol(),
+                                       clockSync->timestamp());
 
-    cpr::CurlHolder holder;
-    payload.AddPair({"sign", HmacEncode(payload.content, apiSecret)}, holder);
+    rateLimiter->acquire(cancelAllEndpoint, RequestPriority::Critical);
+    cpr::Response r = ApiPost(body, cancelAllEndpoint);
+    dom::element response = parseApiResponse(r);
 
-    cpr::Response r = ApiPost(payload, endpoint);
-    dom::parser parser;
-    dom::element response = parser.parse(r.text);
-
-    int retCode = response["ret_code"].get_int64();
+    int retCode = checkPrivateResponse(cancelAllEndpoint, response);
 
     if (retCode != 0) {
-        spdlog::error("Bybit::cancelAllActiveOrders - bad response - " + (std::string)response["ret_msg"]);
+        BYTRA_LOG_ERROR("Bybit::cancelAllActiveOrders - bad response - {}", std::string_view(response["ret_msg"]));
         throw std::runtime_error("Bad API response.");
     }
 }
 
 void Bybit::connect(net::io_context &ioc, ssl::context &ctx) {
+    if (!orderGateway) {
+        // Reports are handed back to the market data thread through the io_context
+        orderGateway = std::make_unique<OrderGateway>(
+            [this](const OrderRequest &request) { return executeOrderRequest(request); },
+            [this, &ioc] { net::post(ioc, [this] { processOrderReports(); }); },
+            [this](const OrderRequest &request) {
+                return rateLimiter->tryAcquire(orderEndpoint(request.type), request.priority);
+            });
+    }
+
+    websocketConnects->increment();
     cancelAllActiveOrders();
+    orderManager->clear();
     loadPosition();
 
-    const std::string port = "443";
-    std::string expires
-        = std::to_string(::duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + 5000);
+    // The host may carry a port, like a local mock exchange does, Bybit itself listens on 443
+    std::string host = websocketHost;
+    std::string port = "443";
 
-    std::string auth_msg = R"({"op":"auth","args":[")" + apiKey + R"(",")" + expires + R"(",")"
-                           + HmacEncode("GET/realtime" + expires, apiSecret) + R"("]})";
-    std::string msg
-        = R"({"op": "subscribe", "args": ["position","order","orderBookL2_25.)" + strategy->getSymbol() + "\",";
+    if (auto colon = websocketHost.rfind(':'); colon != std::string::npos) {
+        host = websocketHost.substr(0, colon);
+        port = websocketHost.substr(colon + 1);
+    }
+
+    std::vector<std::string> topics = {"position", "order", "orderBookL2_25." + strategy->getSymbol()};
 
     for (auto const &[tf, val] : candles) {
-        msg.append("\"klineV2." + tf.symbol + ".");
-        msg.append(strategy->getSymbol());
-        msg.append("\",");
+        topics.push_back("klineV2." + tf.symbol + "." + strategy->getSymbol());
+    }
+
+    // Topics are resolved to their handlers once, here, instead of on every message
+    websocketTopics.clear();
+    marketDataParser->clearTopics();
+    std::string msg = R"({"op": "subscribe", "args": [)";
+
+    for (auto const &topic : topics) {
+        if (topic == "position") {
+            websocketTopics.add(topic, &Bybit::parsePositionMsg);
+        } else if (topic == "order") {
+            websocketTopics.add(topic, &Bybit::parseOrderMsg);
+        } else if (topic.rfind("klineV2.", 0) == 0) {
+            websocketTopics.add(topic, &Bybit::parseKlineMsg);
+        } else {
+            websocketTopics.add(topic, &Bybit::parseOrderBookMsg);
+        }
+
+        marketDataParser->addTopic(topic);
+        msg.append("\"" + topic + "\",");
     }
 
     msg.pop_back();
@@ -198,13 +375,13 @@ void Bybit::connect(net::io_context &ioc, ssl::context &ctx) {
         websocket::stream<ssl::stream<tcp::socket>>{ioc, ctx});
 
     // Set SNI Hostname (many hosts need this to handshake successfully)
-    if (!SSL_set_tlsext_host_name(websocket->next_layer().native_handle(), websocketHost.c_str())) {
+    if (!SSL_set_tlsext_host_name(websocket->next_layer().native_handle(), host.c_str())) {
         boost::system::error_code ec{static_cast<int>(::ERR_get_error()), boost::asio::error::get_ssl_category()};
         throw boost::system::system_error{ec};
     }
 
     // Look up the domain name
-    auto const results = resolver.resolve(websocketHost, port);
+    auto const results = resolver.resolve(host, port);
 
     // Make the connection on the IP address we get from a lookup
     net::connect(websocket->next_layer().next_layer(), results);
@@ -220,18 +397,45 @@ void Bybit::connect(net::io_context &ioc, ssl::context &ctx) {
     // Perform the websocket handshake
     websocket->handshake(websocketHost, websocketTarget);
 
+    // Signed after the handshakes, so the auth message only has to stay valid for the time it takes to arrive
+    std::string expires = std::to_string(clockSync->timestamp() + recvWindow.count());
+    std::string auth_msg = R"({"op":"auth","args":[")" + apiKey + R"(",")" + expires + R"(",")"
+                           + signer->sign("GET/realtime" + expires) + R"("]})";
+
     // Send the message
     websocket->write(net::buffer(auth_msg));
     websocket->write(net::buffer(msg));
+
+    // Timers run on the same io_context as the websocket, so they fire even when no messages arrive
+    batchSize = 0;
+    heartbeatTimer = std::make_unique<net::steady_timer>(ioc);
+    orderBookSyncTimer = std::make_unique<net::steady_timer>(ioc);
+    stopLossTimer = std::make_unique<net::steady_timer>(ioc);
+    candleCloseTimer = std::make_unique<net::steady_timer>(ioc);
+    chaseTimer = std::make_unique<net::steady_timer>(ioc);
+    latencyReportTimer = std::make_unique<net::steady_timer>(ioc);
+    startHeartbeatTimer();
+    startOrderBookSyncTimer();
+    startStopLossTimer();
+    startCandleCloseTimer();
+    startLatencyReportTimer();
+
+    readWebsocket();
 }
 
 [[maybe_unused]] void Bybit::disconnect() {
+    cancelTimers();
+    websocketWriteQueue.clear();
+
     if (!websocket) {
         return;
     }
-    websocket->close(websocket::close_code::normal);
-    websocket->next_layer().shutdown();
-    websocket->next_layer().next_layer().shutdown(boost::asio::socket_base::shutdown_type::shutdown_both);
+
+    // The connection might already be broken, errors are ignored
+    beast::error_code ec;
+    websocket->close(websocket::close_code::normal, ec);
+    websocket->next_layer().shutdown(ec);
+    websocket->next_layer().next_layer().shutdown(boost::asio::socket_base::shutdown_type::shutdown_both, ec);
     websocket.reset();
 }
 
@@ -243,20 +447,288 @@ bool Bybit::isConnected() {
 }
 
 void Bybit::readWebsocket() {
-    websocket->read(websocketBuffer);
+    websocket->async_read(websocketBuffer, [this](const beast::error_code &ec, std::size_t) { onWebsocketRead(ec); });
+}
+
+void Bybit::onWebsocketRead(const beast::error_code &ec) {
+    if (ec == net::error::operation_aborted) {
+        return;
+    }
+
+    if (ec) {
+        // Stop the timers so the io_context runs out of work and the caller can reconnect
+        cancelTimers();
+
+        if (ec == net::error::eof || ec == websocket::error::closed) {
+            BYTRA_LOG_ERROR("boost::system::system_error: {}", ec.message());
+            return;
+        }
+
+        throw boost::system::system_error(ec);
+    }
+
+    auto frameTime = steady_clock::now();
+
+    websocketMessages->increment();
+
+    if (batchSize++ == 0) {
+        batchStart = frameTime;
+    }
 
     // Check for a message in our buffer
     if (websocketBuffer.size() != 0) {
-        parseWebsocketMsg(beast::buffers_to_string(websocketBuffer.data()));
-        websocketBuffer.clear();
+        // Parse straight from the buffer, simdjson only needs the padding after the message to be readable
+        websocketBuffer.prepare(SIMDJSON_PADDING);
+        parseWebsocketMsg(static_cast<const uint8_t *>(websocketBuffer.data().data()), websocketBuffer.size());
+        websocketBuffer.consume(websocketBuffer.size());
+        latency->record(LatencyStage::Parse, frameTime);
+    }
+
+    // Apply every frame that already arrived before trading on the resulting state
+    if (batchSize < maxBatchSize && steady_clock::now() - batchStart < batchLatencyBudget
+        && isWebsocketDataAvailable()) {
+        readWebsocket();
+        return;
+    }
+
+    batchSize = 0;
+    triggerTime = batchStart;
+    auto tradingStart = steady_clock::now();
+    doAutomatedTrading();
+    latency->record(LatencyStage::Strategy, tradingStart);
+    removeUnusedCandles();
+
+    readWebsocket();
+}
+
+bool Bybit::isWebsocketDataAvailable() {
+    // Data can be waiting on the socket or already be decrypted inside the SSL stream
+    beast::error_code ec;
+    return websocket->next_layer().next_layer().available(ec) > 0
+           || SSL_pending(websocket->next_layer().native_handle()) > 0;
+}
+
+void Bybit::setIngestBatching(const size_t &maxBatchSize, const microseconds &batchLatencyBudget) {
+    this->maxBatchSize = std::max<size_t>(maxBatchSize, 1);
+    this->batchLatencyBudget = batchLatencyBudget;
+}
+
+void Bybit::setBoundaryDecisions(const bool &enabled) { boundaryDecisions = enabled; }
+
+void Bybit::setChasing(const LimitOrderChaser::Settings &settings) {
+    chaser = LimitOrderChaser(settings);
+    tickSize = settings.tickSize;
+}
+
+void Bybit::setRecvWindow(const milliseconds &window) { recvWindow = window; }
+
+const ClockSync &Bybit::getClockSync() const { return *clockSync; }
+
+void Bybit::setLatencyReportInterval(const seconds &interval) { latencyReportInterval = interval; }
+
+LatencyStats &Bybit::getLatencyStats() { return *latency; }
+
+std::shared_ptr<Metrics> Bybit::getMetrics() const { return metrics; }
+
+void Bybit::registerMetrics(const std::vector<std::string> &endpoints) {
+    metrics = std::make_shared<Metrics>();
+    websocketMessages = &metrics->counter("bytra_websocket_messages_total", "Websocket frames received");
+    websocketConnects = &metrics->counter("bytra_websocket_connects_total", "Websocket (re)connections");
+    orderBookResyncs = &metrics->counter("bytra_orderbook_resyncs_total", "Order book resubscriptions");
+    orderRequestFailures
+        = &metrics->counter("bytra_order_request_failures_total", "Order requests rejected by the API or failed");
+    workingOrders = &metrics->gauge("bytra_working_orders", "Orders placed this session that are not finished");
+    orderBacklog = &metrics->gauge("bytra_order_requests_in_flight", "Order requests waiting for their response");
+    positionQty = &metrics->gauge("bytra_position_qty", "Position size in contracts, negative when short");
+
+    for (const auto &endpoint : endpoints) {
+        std::string label = "endpoint=\"" + endpoint + "\"";
+        RestMetrics &restMetrics = restEndpointMetrics[endpoint];
+        restMetrics.requests = &metrics->counter("bytra_rest_requests_total", "REST requests with a response", label);
+        restMetrics.errors = &metrics->counter("bytra_rest_errors_total", "REST responses with an error status", label);
+        restMetrics.rateLimited
+            = &metrics->counter("bytra_rest_rate_limited_total", "REST requests refused by the rate limit", label);
+
+        // Already filled or cancelled orders, too many visits and expired requests
+        for (int retCode : {20001, 30032, 30037, 10006, 10002}) {
+            restMetrics.apiErrors[retCode]
+                = &metrics->counter(apiErrorsName, apiErrorsHelp, apiErrorsLabel(endpoint, retCode));
+        }
+    }
+
+    // The clock offset is kept in atomics, so it can be read from the metrics server thread
+    metrics->gauge("bytra_clock_offset_seconds", "Exchange clock minus local clock",
+                   [this] { return duration<double>(clockSync->offset()).count(); });
+    metrics->gauge("bytra_clock_rtt_seconds", "Round trip of the server time sample the offset is taken from",
+                   [this] { return duration<double>(clockSync->rtt()).count(); });
+
+    metrics->addCollector([this](std::string &out) {
+        out += "# HELP bytra_latency_seconds Latency percentiles since the last latency report\n"
+               "# TYPE bytra_latency_seconds gauge\n";
+
+        for (const auto &[name, snapshot] : latency->snapshot()) {
+            std::string label = (name[0] == '/' ? "endpoint=\"" : "stage=\"") + name + "\"";
+
+            for (double quantile : {0.5, 0.99, 0.999}) {
+                out += fmt::format("bytra_latency_seconds{{{},quantile=\"{}\"}} {}\n", label, quantile,
+                                   snapshot.percentile(quantile * 100) / 1e9);
+            }
+
+            out += fmt::format("bytra_latency_seconds{{{},quantile=\"1\"}} {}\n", label, snapshot.max / 1e9);
+        }
+    });
+}
+
+void Bybit::updateOrderGauges() {
+    workingOrders->set(static_cast<double>(orderManager->workingOrders()));
+    orderBacklog->set(static_cast<double>(orderGateway->requestsInFlight()));
+}
+
+void Bybit::writeWebsocket(std::string msg) {
+    websocketWriteQueue.push_back(std::move(msg));
+
+    // Only one write can be outstanding, the others are sent from onWebsocketWrite
+    if (websocketWriteQueue.size() > 1) {
+        return;
+    }
+
+    websocket->async_write(net::buffer(websocketWriteQueue.front()),
+                           [this](const beast::error_code &ec, std::size_t) { onWebsocketWrite(ec); });
+}
+
+void Bybit::onWebsocketWrite(const beast::error_code &ec) {
+    if (ec) {
+        BYTRA_LOG_ERROR("Bybit::onWebsocketWrite - {}", ec.message());
+        websocketWriteQueue.clear();
+        return;
+    }
+
+    websocketWriteQueue.pop_front();
+
+    if (!websocketWriteQueue.empty() && isConnected()) {
+        websocket->async_write(net::buffer(websocketWriteQueue.front()),
+                               [this](const beast::error_code &ec, std::size_t) { onWebsocketWrite(ec); });
+    }
+}
+
+void Bybit::startHeartbeatTimer() {
+    // Send heartbeat packet every 45 seconds to maintain websocket connection
+    heartbeatTimer->expires_after(seconds(45));
+    heartbeatTimer->async_wait([this](const beast::error_code &ec) {
+        if (ec) {
+            return;
+        }
+
+        sendWebsocketHeartbeat();
+        startHeartbeatTimer();
+    });
+}
+
+void Bybit::startOrderBookSyncTimer() {
+    // Sync order book after an hour
+    orderBookSyncTimer->expires_after(hours(1));
+    orderBookSyncTimer->async_wait([this](const beast::error_code &ec) {
+        if (ec) {
+            return;
+        }
+
+        syncOrderBook();
+        startOrderBookSyncTimer();
+    });
+}
+
+void Bybit::startStopLossTimer() {
+    // Poll the stop loss so it is also checked in a quiet market
+    stopLossTimer->expires_after(seconds(1));
+    stopLossTimer->async_wait([this](const beast::error_code &ec) {
+        if (ec) {
+            return;
+        }
+
+        triggerTime = steady_clock::now();
+        checkStopLoss();
+        startStopLossTimer();
+    });
+}
+
+void Bybit::startCandleCloseTimer() {
+    if (!boundaryDecisions || !triggerLevelsReady || !candleCloseTimer) {
+        return;
+    }
+
+    // The candle after the last closed one ends two intervals after the last one opened
+    system_clock::time_point close(seconds(signalCandles->back()->timestamp) + 2 * signalInterval);
+    candleCloseTimer->expires_after(close - clockSync->now());
+    candleCloseTimer->async_wait([this](const beast::error_code &ec) {
+        if (ec) {
+            return;
+        }
+
+        triggerTime = steady_clock::now();
+        decideAtCandleClose();
+    });
+}
+
+void Bybit::startChaseTimer() {
+    if (!chaseTimer) {
+        return;
+    }
+
+    // Sends the amend that was held back by the chaser, with the top of the book at that time
+    chaseTimer->expires_at(chaser.nextAmendTime());
+    chaseTimer->async_wait([this](const beast::error_code &ec) {
+        if (ec) {
+            return;
+        }
+
+        triggerTime = steady_clock::now();
+        chaseActiveOrder();
+    });
+}
+
+void Bybit::startLatencyReportTimer() {
+    if (latencyReportInterval == seconds(0)) {
+        return;
+    }
+
+    latencyReportTimer->expires_after(latencyReportInterval);
+    latencyReportTimer->async_wait([this](const beast::error_code &ec) {
+        if (ec) {
+            return;
+        }
+
+        latency->log();
+        startLatencyReportTimer();
+    });
+}
+
+void Bybit::cancelTimers() {
+    for (auto *timer : {heartbeatTimer.get(), orderBookSyncTimer.get(), stopLossTimer.get(), candleCloseTimer.get(),
+                        chaseTimer.get(), latencyReportTimer.get()}) {
+        if (timer) {
+            timer->cancel();
+        }
+    }
+}
+
+void Bybit::addCandle(const std::string_view &interval, const Candle &candle) {
+    for (auto &[tf, vec] : candles) {
+        if (tf.symbol == interval && vec.back()->timestamp != candle.timestamp) {
+            vec.push_back(std::make_shared<Candle>(candle));
+            pendingEvents |= CandleClosed;
+            BYTRA_LOG_DEBUG("Added Candle");
+            break;
+        }
     }
 }
 
-void Bybit::parseWebsocketMsg(const std::string &msg) {
-    //std::cout << msg << std::endl;
+void Bybit::parseWebsocketMsg(const uint8_t *buf, const size_t &len) {
+    // Fast path for the order book and kline messages, everything else goes through the DOM
+    if (marketDataParser->parse(buf, len)) {
+        return;
+    }
 
-    dom::parser parser;
-    dom::element response = parser.parse(msg);
+    dom::element response = websocketParser.parse(buf, len, false);
     dom::element elem;
 
     // authentication and subscribe messages
@@ -264,410 +736,692 @@ void Bybit::parseWebsocketMsg(const std::string &msg) {
         bool success = (bool) response["success"];
 
         if(!success) {
-            spdlog::error("Websocket: {}", (std::string) response["ret_msg"]);
+            BYTRA_LOG_ERROR("Websocket: {}", std::string_view(response["ret_msg"]));
             return;
         }
 
-        std::string op = (std::string)response["request"]["op"];
+        std::string_view op = response["request"]["op"];
 
         if (op == "auth") {
             std::cout << "Connected and authenticated with Bybit websocket " << GREEN << "✔" << RESET << std::endl;
-            spdlog::info("[WebSocket] Connected to the Bybit Realtime API.");
+            BYTRA_LOG_INFO("[WebSocket] Connected to the Bybit Realtime API.");
 
         } else if (op == "subscribe") {
             for (dom::element item : response["request"]["args"]) {
-                spdlog::info("[WebSocket] Successfully subscribed to " + (std::string)item);
+                BYTRA_LOG_INFO("[WebSocket] Successfully subscribed to {}", std::string_view(item));
             }
         }
         return;
     }
 
     if (auto error = response["topic"].get(elem); !error) {
-        std::string topic = (std::string)response["topic"];
+        if (auto handler = websocketTopics.find(std::string_view(elem))) {
+            (this->*(*handler))(response);
+        }
+    } else {
+        BYTRA_LOG_DEBUG("websocket msg: {}", std::string_view(reinterpret_cast<const char *>(buf), len));
+    }
+}
 
-        if (topic == "position") {
-            for (dom::object item : response["data"]) {
-                double entryPrice = std::stod((std::string)item["entry_price"]);
-                std::string side = (std::string)item["side"];
-                long qty = (long)item["size"];
-                if (side == "Sell") {
-                    qty = -qty;
-                }
+void Bybit::parsePositionMsg(const dom::element &response) {
+    for (dom::object item : response["data"]) {
+        double entryPrice = toDouble(item["entry_price"]);
+        std::string_view side = item["side"];
+        long qty = (long)item["size"];
+        if (side == "Sell") {
+            qty = -qty;
+        }
 
-                position->update(qty, entryPrice);
-            }
+        position->update(qty, entryPrice);
+    }
 
-        } else if (topic == "order") {
-            for (dom::object item : response["data"]) {
-                std::string orderType = (std::string)item["order_type"];
-                std::string orderStatus = (std::string)item["order_status"];
-                double askPrice = orderBook->askPrice();
-                double bidPrice = orderBook->bidPrice();
-
-                if (orderStatus == "Cancelled" && position->activeOrder) {
-                    if (position->activeOrder->isBuy()) {
-                        if (bidPrice >= position->activeOrder->priceInterval.first
-                            && bidPrice <= position->activeOrder->priceInterval.second) {
-                            position->activeOrder->price = bidPrice;
-                            placeLimitOrder(*position->activeOrder);
-                        } else if (position->activeOrder->reduce) {
-                            placeMarketOrder(*position->activeOrder);
-                        } else {
-                            position->activeOrder = nullptr;
-                        }
-                    } else {
-                        if (askPrice >= position->activeOrder->priceInterval.first
-                            && askPrice <= position->activeOrder->priceInterval.second) {
-                            position->activeOrder->price = askPrice;
-                            placeLimitOrder(*position->activeOrder);
-                        } else if (position->activeOrder->reduce) {
-                            placeMarketOrder(*position->activeOrder);
-                        } else {
-                            position->activeOrder = nullptr;
-                        }
-                    }
-                } else if (orderStatus == "Filled") {
-                    position->activeOrder = nullptr;
+    pendingEvents |= PositionChanged;
+}
+
+void Bybit::parseOrderMsg(const dom::element &response) {
+    for (dom::object item : response["data"]) {
+        std::string_view linkId;
+        std::string_view orderStatus = item["order_status"];
+        int64_t filledQty = 0;
+
+        if (item["order_link_id"].get(linkId) || item["cum_exec_qty"].get(filledQty)) {
+            continue;
+        }
+
+        const ManagedOrder *managed = orderManager->onExecutionReport(linkId, orderStatus, filledQty);
+
+        // Orders placed outside of this session are not ours to manage
+        if (managed == nullptr) {
+            continue;
+        }
+
+        OrderState state = managed->state;
+        bool isActiveOrder = position->activeOrder && position->activeOrder->linkId == linkId;
+
+        if (managed->isFinished()) {
+            orderManager->remove(linkId);
+        }
+
+        if (!isActiveOrder) {
+            continue;
+        }
+
+        double askPrice = orderBook->askPrice();
+        double bidPrice = orderBook->bidPrice();
+
+        if (state == OrderState::Cancelled) {
+            // The exchange cancelled our order, replace it with a new one
+            Order ord = *position->activeOrder;
+            dropActiveOrder();
+
+            if (ord.isBuy()) {
+                if (bidPrice >= ord.priceInterval.first && bidPrice <= ord.priceInterval.second) {
+                    ord.price = bidPrice;
+                    placeLimitOrder(ord);
+                } else if (ord.reduce) {
+                    placeMarketOrder(ord);
+                }
+            } else {
+                if (askPrice >= ord.priceInterval.first && askPrice <= ord.priceInterval.second) {
+                    ord.price = askPrice;
+                    placeLimitOrder(ord);
+                } else if (ord.reduce) {
+                    placeMarketOrder(ord);
                 }
             }
-        } else if (topic.size() > 7 && topic.substr(0, 7) == "klineV2") {
-            std::string::size_type n = topic.find('.');
-            std::string::size_type n2 = topic.find('.', n + 1);
+        } else if (state == OrderState::Filled) {
+            dropActiveOrder();
+        }
+    }
 
-            std::string interval = topic.substr(n + 1, n2 - n - 1);
-            std::string symbol = topic.substr(n2 + 1);
+    pendingEvents |= OrderStateChanged;
+}
 
-            for (dom::object item : response["data"]) {
-                bool confirm = (bool)item["confirm"];
-                if (!confirm) {
-                    continue;
-                }
+void Bybit::parseKlineMsg(const dom::element &response) {
+    // Only used when the fast path could not handle the message
+    std::string_view topic = response["topic"];
+    std::string_view::size_type n = topic.find('.');
+    std::string_view::size_type n2 = topic.find('.', n + 1);
 
-                // create candle
-                double open = (double)item["open"];
-                double high = (double)item["high"];
-                double low = (double)item["low"];
-                double close = (double)item["close"];
-                double volume = (double)item["volume"];
-                long timestamp = (long)item["start"];
-                auto candle = std::make_shared<Candle>(Candle{open, high, low, close, volume, timestamp});
+    std::string_view interval = topic.substr(n + 1, n2 - n - 1);
 
-                // add candle
-                for (auto &[tf, vec] : candles) {
-                    if (tf.symbol == interval && vec.back()->timestamp != candle->timestamp) {
-                        vec.push_back(candle);
-                        newCandleAdded = true;
-                        spdlog::debug("Added Candle");
-                        break;
-                    }
-                }
+    for (dom::object item : response["data"]) {
+        bool confirm = (bool)item["confirm"];
+        if (!confirm) {
+            continue;
+        }
+
+        // create candle
+        double open = (double)item["open"];
+        double high = (double)item["high"];
+        double low = (double)item["low"];
+        double close = (double)item["close"];
+        double volume = (double)item["volume"];
+        long timestamp = (long)item["start"];
+        addCandle(interval, Candle{open, high, low, close, volume, timestamp});
+    }
+}
+
+void Bybit::parseOrderBookMsg(const dom::element &response) {
+    // Only used when the fast path could not handle the message
+    std::string_view type = response["type"];
+
+    if (type == "snapshot") {
+        orderBook->clear();
+
+        for (dom::object item : response["data"]) {
+            long id = (long)item["id"];
+            double price = toDouble(item["price"]);
+            std::string_view side = item["side"];
+            long size = (long)item["size"];
+
+            if (side == "Sell") {
+                orderBook->addAskEntry(id, OrderBookEntry(price, size));
+            } else if (side == "Buy") {
+                orderBook->addBidEntry(id, OrderBookEntry(price, size));
             }
-        } else if (topic.size() > 14 && topic.substr(0, 14) == "orderBookL2_25") {
-            std::string type = (std::string)response["type"];
-
-            if (type == "snapshot") {
-                orderBook = std::make_shared<OrderBook>();
-
-                for (dom::object item : response["data"]) {
-                    long id = (long)item["id"];
-                    double price = std::stod((std::string)item["price"]);
-                    std::string side = (std::string)item["side"];
-                    long size = (long)item["size"];
-
-                    if (side == "Sell") {
-                        orderBook->addAskEntry(id, OrderBookEntry(price, size));
-                    } else if (side == "Buy") {
-                        orderBook->addBidEntry(id, OrderBookEntry(price, size));
-                    }
-                }
+        }
 
-            } else if (type == "delta") {
-                for (dom::object item : response["data"]["delete"]) {
-                    long id = (long)item["id"];
-                    std::string side = (std::string)item["side"];
+    } else if (type == "delta") {
+        for (dom::object item : response["data"]["delete"]) {
+            long id = (long)item["id"];
+            std::string_view side = item["side"];
 
-                    if (side == "Sell") {
-                        orderBook->removeAskEntry(id);
-                    } else if (side == "Buy") {
-                        orderBook->removeBidEntry(id);
-                    }
-                }
+            if (side == "Sell") {
+                orderBook->removeAskEntry(id);
+            } else if (side == "Buy") {
+                orderBook->removeBidEntry(id);
+            }
+        }
 
-                for (dom::object item : response["data"]["update"]) {
-                    long id = (long)item["id"];
-                    std::string side = (std::string)item["side"];
-                    long size = (long)item["size"];
+        for (dom::object item : response["data"]["update"]) {
+            long id = (long)item["id"];
+            std::string_view side = item["side"];
+            long size = (long)item["size"];
 
-                    if (side == "Sell") {
-                        orderBook->updateAskEntry(id, size);
-                    } else if (side == "Buy") {
-                        orderBook->updateBidEntry(id, size);
-                    }
-                }
+            if (side == "Sell") {
+                orderBook->updateAskEntry(id, size);
+            } else if (side == "Buy") {
+                orderBook->updateBidEntry(id, size);
+            }
+        }
 
-                for (dom::object item : response["data"]["insert"]) {
-                    long id = (long)item["id"];
-                    double price = std::stod((std::string)item["price"]);
-                    std::string side = (std::string)item["side"];
-                    long size = (long)item["size"];
-
-                    if (side == "Sell") {
-                        orderBook->addAskEntry(id, OrderBookEntry(price, size));
-                    } else if (side == "Buy") {
-                        orderBook->addBidEntry(id, OrderBookEntry(price, size));
-                    }
-                }
+        for (dom::object item : response["data"]["insert"]) {
+            long id = (long)item["id"];
+            double price = toDouble(item["price"]);
+            std::string_view side = item["side"];
+            long size = (long)item["size"];
+
+            if (side == "Sell") {
+                orderBook->addAskEntry(id, OrderBookEntry(price, size));
+            } else if (side == "Buy") {
+                orderBook->addBidEntry(id, OrderBookEntry(price, size));
             }
         }
-    } else {
-        spdlog::debug("websocket msg: {}", msg);
     }
 }
 
 void Bybit::sendWebsocketHeartbeat() {
     if (isConnected()) {
-        websocket->write(net::buffer(R"({"op":"ping"})"));
+        writeWebsocket(R"({"op":"ping"})");
     }
 }
 
 void Bybit::syncOrderBook() {
     if (isConnected()) {
-        websocket->write(
-            net::buffer(R"({"op": "unsubscribe", "args": ["orderBookL2_25.)" + strategy->getSymbol() + R"("]})"));
-        websocket->write(
-            net::buffer(R"({"op": "subscribe", "args": ["orderBookL2_25.)" + strategy->getSymbol() + R"("]})"));
+        orderBookResyncs->increment();
+        writeWebsocket(R"({"op": "unsubscribe", "args": ["orderBookL2_25.)" + strategy->getSymbol() + R"("]})");
+        writeWebsocket(R"({"op": "subscribe", "args": ["orderBookL2_25.)" + strategy->getSymbol() + R"("]})");
     }
 }
 
-void Bybit::placeMarketOrder(const Order &ord) {
-    std::string expires
-        = std::to_string(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + 1000);
+void Bybit::processOrderReports() {
+    orderGateway->processReports();
+    updateOrderGauges();
 
-    std::string endpoint = "/v2/private/order/create";
-    // pairs have to be in alphabetic order
-    cpr::Payload payload
-        = cpr::Payload{{"api_key", apiKey}, {"order_type", "Market"}, {"qty", std::to_string(std::abs(ord.qty))}};
+    if (pendingEvents != NoEvent) {
+        doAutomatedTrading();
+    }
+}
 
-    cpr::CurlHolder holder;
+void Bybit::onOrderReport(const OrderReport &report) {
+    pendingEvents |= OrderStateChanged;
 
-    if (ord.reduce) {
-        payload.AddPair({"reduce_only", "true"}, holder);
+    // Creates, cancels and trading stops have rate limits of their own, only the replace budget limits amends
+    if (report.type == OrderRequestType::Amend && report.rateLimitStatus >= 0) {
+        auto untilReset = duration_cast<steady_clock::duration>(milliseconds(report.rateLimitResetMs)
+                                                                - clockSync->now().time_since_epoch());
+        chaser.onRateLimit(report.rateLimitStatus, steady_clock::now() + untilReset);
     }
+    bool isActiveOrder = position->activeOrder && position->activeOrder->handle == report.order.handle;
 
-    payload.AddPair({"side", ord.qty > 0 ? "Buy" : "Sell"}, holder);
-    payload.AddPair({"symbol", strategy->getSymbol()}, holder);
-    payload.AddPair({"time_in_force", "ImmediateOrCancel"}, holder);
-    payload.AddPair({"timestamp", expires}, holder);
-    payload.AddPair({"sign", HmacEncode(payload.content, apiSecret)}, holder);
+    if (report.failed()) {
+        BYTRA_LOG_ERROR("Bybit::onOrderReport - order request failed - {}", report.error);
+        orderRequestFailures->increment();
 
-    cpr::Response r = ApiPost(payload, endpoint);
-    dom::parser parser;
-    dom::element response = parser.parse(r.text);
+        if (report.type == OrderRequestType::TradingStop) {
+            BYTRA_LOG_WARN("Exchange stop loss not set, only the local stop loss protects the position");
+            requestedStopLossPrice = 0;  // retried with the next position update
+        }
 
-    int retCode = response["ret_code"].get_int64();
+        // A failed amend or cancel is retried by the gateway, the order is still live so it stays active
+        if (report.type == OrderRequestType::Market || report.type == OrderRequestType::Limit) {
+            orderManager->reject(report.order.linkId);
+            orderManager->remove(report.order.linkId);
 
-    if (retCode != 0 && retCode != 30063) {
-        spdlog::error("Bybit::placeMarketOrder - bad response - " + (std::string)response["ret_msg"]);
-        throw std::runtime_error("Bad API response.");
+            if (isActiveOrder) {
+                dropActiveOrder();
+            }
+        }
+        return;
+    }
+
+    switch (report.type) {
+        case OrderRequestType::Limit:
+            orderManager->acknowledge(report.order.linkId, report.orderId);
+
+            if (isActiveOrder) {
+                position->activeOrder->id = report.orderId;
+                BYTRA_LOG_DEBUG("Set activeOrder with price={}, interval=({}, {}), reduce={}",
+                              position->activeOrder->price, position->activeOrder->priceInterval.first,
+                              position->activeOrder->priceInterval.second, position->activeOrder->reduce);
+            }
+            break;
+
+        case OrderRequestType::Amend:
+            if (isActiveOrder
+                && (report.retCode == 30032 || report.retCode == 30037 || report.retCode == 20001)) {
+                dropActiveOrder();
+            }
+            break;
+
+        case OrderRequestType::Market:
+            orderManager->acknowledge(report.order.linkId, report.orderId);
+            break;
+
+        case OrderRequestType::TradingStop:
+            BYTRA_LOG_INFO("Exchange stop loss set at {}", report.order.price);
+            break;
+
+        case OrderRequestType::Cancel:
+            // The gateway cancels an order it couldn't amend
+            if (isActiveOrder) {
+                dropActiveOrder();
+            }
+            break;
     }
+}
 
-    if (ord.reduce) {
+void Bybit::dropActiveOrder() {
+    if (position->activeOrder) {
+        orderGateway->forget(position->activeOrder->handle);
         position->activeOrder = nullptr;
+        chaser.reset();
+    }
+}
+
+OrderReport Bybit::executeOrderRequest(const OrderRequest &request) {
+    latency->record(LatencyStage::Queue, request.submitTime);
+
+    switch (request.type) {
+        case OrderRequestType::Market:
+            return sendMarketOrder(request.order);
+        case OrderRequestType::Limit:
+            return sendLimitOrder(request.order);
+        case OrderRequestType::Amend:
+            return sendAmendLimitOrder(request.order);
+        case OrderRequestType::Cancel:
+            return sendCancelLimitOrder(request.order);
+        case OrderRequestType::TradingStop:
+            return sendTradingStop(request.order);
     }
+
+    throw std::invalid_argument("Invalid order request type.");
+}
+
+void Bybit::placeMarketOrder(const Order &ord) {
+    Order tracked = orderManager->add(ord);
+    marketOrderHandle
+        = orderGateway->submitMarket(tracked, [this](const OrderReport &report) { onOrderReport(report); });
+    latency->record(LatencyStage::TickToOrder, triggerTime);
+    updateOrderGauges();
 }
 
 void Bybit::placeLimitOrder(const Order &ord) {
-    std::string expires
-        = std::to_string(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + 1000);
+    Order tracked = orderManager->add(ord);
+    OrderHandle handle
+        = orderGateway->submitLimit(tracked, [this](const OrderReport &report) { onOrderReport(report); });
+    latency->record(LatencyStage::TickToOrder, triggerTime);
+    updateOrderGauges();
+
+    // The order is active right away, its exchange id is filled in when the order is acknowledged
+    position->activeOrder = std::make_shared<Order>(tracked);
+    position->activeOrder->handle = handle;
+}
+
+void Bybit::amendLimitOrder(const Order &ord) {
+    orderGateway->amend(ord.handle, ord.price);
+    latency->record(LatencyStage::TickToOrder, triggerTime);
+    updateOrderGauges();
+}
 
-    std::string endpoint = "/v2/private/order/create";
-    // pairs have to be in alphabetic order
-    cpr::Payload payload = cpr::Payload{{"api_key", apiKey},
-                                        {"order_type", "Limit"},
-                                        {"price", std::to_string(ord.price)},
-                                        {"qty", std::to_string(std::abs(ord.qty))}};
+void Bybit::cancelActiveLimitOrder() {
+    orderGateway->cancel(position->activeOrder->handle);
+    position->activeOrder = nullptr;
+    chaser.reset();
+}
 
-    cpr::CurlHolder holder;
+OrderReport Bybit::sendMarketOrder(const Order &ord) {
+    auto signStart = steady_clock::now();
+    std::string_view body;
 
-    if (ord.reduce) {
-        payload.AddPair({"reduce_only", "true"}, holder);
+    if (ord.prepared && ord.prepared->isPreparedFrom(marketOrderRequest)) {
+        body = requestBuilder().build(*ord.prepared, *signer, ord.linkId, clockSync->timestamp());
+    } else {
+        body = requestBuilder().build(marketOrderRequest, *signer, apiKey, ord.linkId, "Market", std::abs(ord.qty),
+                                      recvWindow.count(),
+                                      ord.reduce ? std::optional<std::string_view>("true") : std::nullopt,
+                                      ord.qty > 0 ? "Buy" : "Sell", strategy->getSymbol(), "ImmediateOrCancel",
+                                      clockSync->timestamp());
     }
 
-    payload.AddPair({"side", ord.qty > 0 ? "Buy" : "Sell"}, holder);
-    payload.AddPair({"symbol", strategy->getSymbol()}, holder);
-    payload.AddPair({"time_in_force", "PostOnly"}, holder);
-    payload.AddPair({"timestamp", expires}, holder);
-    payload.AddPair({"sign", HmacEncode(payload.content, apiSecret)}, holder);
+    latency->record(LatencyStage::Sign, signStart);
 
-    cpr::Response r = ApiPost(payload, endpoint);
-    dom::parser parser;
-    dom::element response = parser.parse(r.text);
+    cpr::Response r = ApiPost(body, createOrderEndpoint);
+    dom::element response = parseApiResponse(r);
 
-    int retCode = response["ret_code"].get_int64();
+    int retCode = checkPrivateResponse(createOrderEndpoint, response);
 
-    if (retCode != 0) {
-        spdlog::error("Bybit::placeLimitOrder - bad response - " + (std::string)response["ret_msg"]);
+    if (retCode != 0 && retCode != 30063) {
+        BYTRA_LOG_ERROR("Bybit::placeMarketOrder - bad response - {}", std::string_view(response["ret_msg"]));
         throw std::runtime_error("Bad API response.");
     }
 
-    position->activeOrder = std::make_shared<Order>(ord);
-    position->activeOrder->id = (std::string)response["result"]["order_id"];
-    spdlog::debug("Set activeOrder with price={}, interval=({}, {}), reduce={}", position->activeOrder->price,
-                  position->activeOrder->priceInterval.first, position->activeOrder->priceInterval.second,
-                  position->activeOrder->reduce);
+    OrderReport report{OrderRequestType::Market, ord, retCode};
+    readRateLimit(response, report);
+    return report;
 }
 
-void Bybit::amendLimitOrder(const Order &ord) {
-    std::string expires
-        = std::to_string(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + 1000);
+OrderReport Bybit::sendLimitOrder(const Order &ord) {
+    auto signStart = steady_clock::now();
+    std::string_view body;
 
-    std::string endpoint = "/open-api/order/replace";
-    // pairs have to be in alphabetic order
-    cpr::Payload payload = cpr::Payload{{"api_key", apiKey},
-                                        {"order_id", ord.id},
-                                        {"p_r_price", std::to_string(ord.price)},
-                                        {"symbol", strategy->getSymbol()},
-                                        {"timestamp", expires}};
+    if (ord.prepared && ord.prepared->isPreparedFrom(limitOrderRequest)) {
+        body = requestBuilder().build(*ord.prepared, *signer, ord.linkId, Decimal{ord.price}, clockSync->timestamp());
+    } else {
+        body = requestBuilder().build(limitOrderRequest, *signer, apiKey, ord.linkId, "Limit", Decimal{ord.price},
+                                      std::abs(ord.qty), recvWindow.count(),
+                                      ord.reduce ? std::optional<std::string_view>("true") : std::nullopt,
+                                      ord.qty > 0 ? "Buy" : "Sell", strategy->getSymbol(), "PostOnly",
+                                      clockSync->timestamp());
+    }
 
-    cpr::CurlHolder holder;
-    payload.AddPair({"sign", HmacEncode(payload.content, apiSecret)}, holder);
+    latency->record(LatencyStage::Sign, signStart);
 
-    cpr::Response r = ApiPost(payload, endpoint);
-    dom::parser parser;
-    dom::element response = parser.parse(r.text);
+    cpr::Response r = ApiPost(body, createOrderEndpoint);
+    dom::element response = parseApiResponse(r);
 
-    int retCode = response["ret_code"].get_int64();
+    int retCode = checkPrivateResponse(createOrderEndpoint, response);
 
-    if (retCode != 0 && retCode != 30032 && retCode != 30037 && retCode != 20001) {
-        spdlog::error("Bybit::amendLimitOrder - bad response - " + (std::string)response["ret_msg"]);
+    if (retCode != 0) {
+        BYTRA_LOG_ERROR("Bybit::placeLimitOrder - bad response - {}", std::string_view(response["ret_msg"]));
         throw std::runtime_error("Bad API response.");
     }
 
-    if (retCode == 30032 || retCode == 30037 || retCode == 20001) {
-        position->activeOrder = nullptr;
+    std::string_view orderId = response["result"]["order_id"];
+    OrderReport report{OrderRequestType::Limit, ord, retCode, std::string(orderId)};
+    readRateLimit(response, report);
+    return report;
+}
+
+OrderReport Bybit::sendAmendLimitOrder(const Order &ord) {
+    auto signStart = steady_clock::now();
+    auto body = requestBuilder().build(replaceOrderRequest, *signer, apiKey, ord.id, Decimal{ord.price},
+                                       recvWindow.count(), strategy->getSymbol(), clockSync->timestamp());
+    latency->record(LatencyStage::Sign, signStart);
+
+    cpr::Response r = ApiPost(body, replaceOrderEndpoint);
+    dom::element response = parseApiResponse(r);
+
+    int retCode = checkPrivateResponse(replaceOrderEndpoint, response);
+
+    if (retCode != 0 && retCode != 30032 && retCode != 30037 && retCode != 20001) {
+        BYTRA_LOG_ERROR("Bybit::amendLimitOrder - bad response - {}", std::string_view(response["ret_msg"]));
+        throw std::runtime_error("Bad API response.");
     }
+
+    OrderReport report{OrderRequestType::Amend, ord, retCode};
+    readRateLimit(response, report);
+    return report;
 }
 
-void Bybit::cancelActiveLimitOrder() {
-    std::string expires
-        = std::to_string(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() + 1000);
+OrderReport Bybit::sendCancelLimitOrder(const Order &ord) {
+    auto signStart = steady_clock::now();
+    auto body = requestBuilder().build(cancelOrderRequest, *signer, apiKey, ord.id, recvWindow.count(),
+                                       strategy->getSymbol(), clockSync->timestamp());
+    latency->record(LatencyStage::Sign, signStart);
 
-    std::string endpoint = "/v2/private/order/cancel";
-    // pairs have to be in alphabetic order
-    cpr::Payload payload = cpr::Payload{{"api_key", apiKey},
-                                        {"order_id", position->activeOrder->id},
-                                        {"symbol", strategy->getSymbol()},
-                                        {"timestamp", expires}};
+    cpr::Response r = ApiPost(body, cancelOrderEndpoint);
+    dom::element response = parseApiResponse(r);
 
-    cpr::CurlHolder holder;
-    payload.AddPair({"sign", HmacEncode(payload.content, apiSecret)}, holder);
+    int retCode = checkPrivateResponse(cancelOrderEndpoint, response);
 
-    cpr::Response r = ApiPost(payload, endpoint);
-    dom::parser parser;
-    dom::element response = parser.parse(r.text);
+    if (retCode != 0 && retCode != 30032 && retCode != 30037 && retCode != 20001) {
+        BYTRA_LOG_ERROR("Bybit::cancelLimitOrder - bad response - {}", std::string_view(response["ret_msg"]));
+        throw std::runtime_error("Bad API response.");
+    }
 
-    int retCode = response["ret_code"].get_int64();
+    OrderReport report{OrderRequestType::Cancel, ord, retCode};
+    readRateLimit(response, report);
+    return report;
+}
 
-    if (retCode != 0 && retCode != 30032) {
-        spdlog::error("Bybit::cancelLimitOrder - bad response - " + (std::string)response["ret_msg"]);
+OrderReport Bybit::sendTradingStop(const Order &ord) {
+    auto signStart = steady_clock::now();
+    auto body = requestBuilder().build(tradingStopRequest, *signer, apiKey, recvWindow.count(), "LastPrice",
+                                       Decimal{ord.price}, strategy->getSymbol(), clockSync->timestamp());
+    latency->record(LatencyStage::Sign, signStart);
+
+    cpr::Response r = ApiPost(body, tradingStopEndpoint);
+    dom::element response = parseApiResponse(r);
+
+    int retCode = checkPrivateResponse(tradingStopEndpoint, response);
+
+    if (retCode != 0) {
+        BYTRA_LOG_ERROR("Bybit::setTradingStop - bad response - {}", std::string_view(response["ret_msg"]));
         throw std::runtime_error("Bad API response.");
     }
 
-    position->activeOrder = nullptr;
+    OrderReport report{OrderRequestType::TradingStop, ord, retCode};
+    readRateLimit(response, report);
+    return report;
 }
 
 void Bybit::doAutomatedTrading() {
-    if (newCandleAdded) {
-        newCandleAdded = false;
+    if (!orderBook->isEmpty()) {
+        double bidPrice = orderBook->bidPrice();
+        double askPrice = orderBook->askPrice();
+
+        if (bidPrice != lastBidPrice || askPrice != lastAskPrice) {
+            lastBidPrice = bidPrice;
+            lastAskPrice = askPrice;
+            pendingEvents |= TopOfBookChanged;
+        }
+    }
 
-        if (position->qty != 0) {
-            auto exit = strategy->checkExit(candles, position);
+    if (pendingEvents == NoEvent) {
+        return;
+    }
 
-            if (exit) {
-                spdlog::debug("Exit signal");
+    // Each piece of trading logic only runs for the events it subscribed to, in this order.
+    // A handler returns true when the rest of the pass has to be skipped.
+    static constexpr std::pair<unsigned, bool (Bybit::*)()> tradingHandlers[] = {
+        {CandleClosed, &Bybit::checkSignals},
+        {TopOfBookChanged | OrderStateChanged, &Bybit::chaseActiveOrder},
+        {TopOfBookChanged | PositionChanged, &Bybit::checkStopLoss},
+    };
 
-                if (position->activeOrder && !position->activeOrder->reduce) {
-                    cancelActiveLimitOrder();
-                }
+    unsigned events = std::exchange(pendingEvents, NoEvent);
 
-                if (strategy->getOrderType() == "Market") {
-                    placeMarketOrder(Order(-position->qty, true));
+    if ((events & PositionChanged) || preparedExit.qty != -position->qty) {
+        positionQty->set(static_cast<double>(position->qty));
+        prepareOrders();
+        syncExchangeStopLoss();
+    }
 
-                } else if (strategy->getOrderType() == "Limit" && !orderBook->isEmpty() && !position->activeOrder) {
-                    double price = position->qty > 0 ? orderBook->askPrice() : orderBook->bidPrice();
-                    Order ord(price, -position->qty, strategy->getSlippage(), true);
-                    placeLimitOrder(ord);
-                    return;
-                }
-            }
+    for (auto const &[subscribedEvents, handler] : tradingHandlers) {
+        if ((events & subscribedEvents) && (this->*handler)()) {
+            return;
         }
+    }
+}
 
-        if (position->qty == 0 && !position->activeOrder && strategy->checkLongEntry(candles)) {
-            spdlog::debug("Entry signal: Long");
+// Serializes everything of an order request except the order_link_id, the price, the timestamp and the signature
+Order Bybit::prepareOrder(Order ord) {
+    auto reduceOnly = ord.reduce ? std::optional<std::string_view>("true") : std::nullopt;
+    auto side = ord.qty > 0 ? "Buy" : "Sell";
 
-            if (strategy->getOrderType() == "Market") {
-                placeMarketOrder(Order(strategy->getQty()));
+    if (strategy->getOrderType() == "Market") {
+        ord.prepared = std::make_shared<const PreparedRequest>(
+            requestBuilder().prepare(marketOrderRequest, apiKey, Deferred{}, "Market", std::abs(ord.qty),
+                                     recvWindow.count(), reduceOnly, side, strategy->getSymbol(), "ImmediateOrCancel",
+                                     Deferred{}));
+    } else {
+        ord.prepared = std::make_shared<const PreparedRequest>(
+            requestBuilder().prepare(limitOrderRequest, apiKey, Deferred{}, "Limit", Deferred{}, std::abs(ord.qty),
+                                     recvWindow.count(), reduceOnly, side, strategy->getSymbol(), "PostOnly",
+                                     Deferred{}));
+    }
 
-            } else if (strategy->getOrderType() == "Limit" && !orderBook->isEmpty()) {
-                Order ord(orderBook->bidPrice(), strategy->getQty(), strategy->getSlippage());
-                placeLimitOrder(ord);
-            }
+    return ord;
+}
 
-            return;
-        } else if (position->qty == 0 && !position->activeOrder && strategy->checkShortEntry(candles)) {
-            spdlog::debug("Entry signal: Short");
+// The orders a signal can lead to with the current position, prepared before the candle closes
+void Bybit::prepareOrders() {
+    preparedLongEntry = prepareOrder(Order(0.0, strategy->getQty(), strategy->getSlippage()));
+    preparedShortEntry = prepareOrder(Order(0.0, -strategy->getQty(), strategy->getSlippage()));
+    preparedExit = position->qty != 0 ? prepareOrder(Order(0.0, -position->qty, strategy->getSlippage(), true))
+                                      : Order();
+}
 
-            if (strategy->getOrderType() == "Market") {
-                placeMarketOrder(Order(-strategy->getQty()));
+Bybit::Signals Bybit::evaluateSignals(const double &close, const bool &useTriggerLevels) {
+    Signals signals;
 
-            } else if (strategy->getOrderType() == "Limit" && !orderBook->isEmpty()) {
-                Order ord(orderBook->askPrice(), -strategy->getQty(), strategy->getSlippage());
-                placeLimitOrder(ord);
-            }
-            return;
+    // A closing market order might still be in flight, the position is updated once it is filled
+    if (position->qty != 0 && !orderGateway->isInFlight(marketOrderHandle)) {
+        if (useTriggerLevels) {
+            signals.exit = (position->isLong() ? triggerLevels.longExit : triggerLevels.shortExit).firesAt(close);
+        } else {
+            signals.exit = strategy->checkExit(candles, position);
+        }
+    } else if (position->qty == 0 && !position->activeOrder) {
+        if (useTriggerLevels) {
+            signals.longEntry = triggerLevels.longEntry.firesAt(close);
+            signals.shortEntry = !signals.longEntry && triggerLevels.shortEntry.firesAt(close);
+        } else {
+            signals.longEntry = strategy->checkLongEntry(candles);
+            signals.shortEntry = !signals.longEntry && strategy->checkShortEntry(candles);
         }
     }
 
-    if (position->activeOrder) {
-        if (position->activeOrder->isBuy()) {
-            double bidPrice = orderBook->bidPrice();
+    return signals;
+}
 
-            if (bidPrice != position->activeOrder->price) {
-                if (bidPrice >= position->activeOrder->priceInterval.first
-                    && bidPrice <= position->activeOrder->priceInterval.second) {
-                    position->activeOrder->price = bidPrice;
-                    amendLimitOrder(*position->activeOrder);
+bool Bybit::placeSignalOrders(const Signals &signals) {
+    if (signals.exit) {
+        BYTRA_LOG_DEBUG("Exit signal");
 
-                } else if (position->activeOrder->reduce) {
-                    cancelActiveLimitOrder();
-                    placeMarketOrder(Order(-position->qty, true));
+        if (position->activeOrder && !position->activeOrder->reduce) {
+            cancelActiveLimitOrder();
+        }
 
-                } else {
-                    cancelActiveLimitOrder();
-                }
-            }
-        } else {
-            double askPrice = orderBook->askPrice();
+        if (strategy->getOrderType() == "Market") {
+            placeMarketOrder(preparedExit);
+
+        } else if (strategy->getOrderType() == "Limit" && !orderBook->isEmpty() && !position->activeOrder) {
+            Order ord = preparedExit;
+            ord.setLimitPrice(position->qty > 0 ? orderBook->askPrice() : orderBook->bidPrice());
+            placeLimitOrder(ord);
+            return true;
+        }
+    }
 
-            if (askPrice != position->activeOrder->price) {
-                if (askPrice >= position->activeOrder->priceInterval.first
-                    && askPrice <= position->activeOrder->priceInterval.second) {
-                    position->activeOrder->price = askPrice;
-                    amendLimitOrder(*position->activeOrder);
+    if (signals.longEntry) {
+        BYTRA_LOG_DEBUG("Entry signal: Long");
 
-                } else if (position->activeOrder->reduce) {
-                    cancelActiveLimitOrder();
-                    placeMarketOrder(Order(-position->qty, true));
+        if (strategy->getOrderType() == "Market") {
+            placeMarketOrder(preparedLongEntry);
 
-                } else {
-                    cancelActiveLimitOrder();
-                }
-            }
+        } else if (strategy->getOrderType() == "Limit" && !orderBook->isEmpty()) {
+            Order ord = preparedLongEntry;
+            ord.setLimitPrice(orderBook->bidPrice());
+            placeLimitOrder(ord);
+        }
+
+        return true;
+    } else if (signals.shortEntry) {
+        BYTRA_LOG_DEBUG("Entry signal: Short");
+
+        if (strategy->getOrderType() == "Market") {
+            placeMarketOrder(preparedShortEntry);
+
+        } else if (strategy->getOrderType() == "Limit" && !orderBook->isEmpty()) {
+            Order ord = preparedShortEntry;
+            ord.setLimitPrice(orderBook->askPrice());
+            placeLimitOrder(ord);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void Bybit::updateTriggerLevels() {
+    triggerLevelsReady = strategy->updateTriggerLevels(candles, triggerLevels);
+    triggerLevelsTimestamp = signalCandles->back()->timestamp;
+    startCandleCloseTimer();
+}
+
+void Bybit::decideAtCandleClose() {
+    if (!triggerLevelsReady || triggerLevelsTimestamp != signalCandles->back()->timestamp || orderBook->isEmpty()) {
+        return;
+    }
+
+    // The confirmed candle is still on its way, the middle of the book stands in for its close price
+    double close = (orderBook->bidPrice() + orderBook->askPrice()) / 2;
+    decidedCandleTimestamp = signalCandles->back()->timestamp + signalInterval.count();
+    BYTRA_LOG_DEBUG("Deciding at candle close with price {}", close);
+
+    if (preparedExit.qty != -position->qty) {
+        prepareOrders();
+    }
+
+    placeSignalOrders(evaluateSignals(close, true));
+}
+
+bool Bybit::checkSignals() {
+    auto &closed = signalCandles->back();
+    bool placed = false;
+
+    // The trigger levels apply to the candle right after the one they were computed from
+    if (closed->timestamp != decidedCandleTimestamp) {
+        bool useTriggerLevels = triggerLevelsReady && signalCandles->size() >= 2
+                                && (*signalCandles)[signalCandles->size() - 2]->timestamp == triggerLevelsTimestamp;
+        placed = placeSignalOrders(evaluateSignals(closed->close, useTriggerLevels));
+    }
+
+    updateTriggerLevels();
+    return placed;
+}
+
+bool Bybit::chaseActiveOrder() {
+    if (!position->activeOrder || orderBook->isEmpty()) {
+        return false;
+    }
+
+    Order &ord = *position->activeOrder;
+    double target = ord.isBuy() ? orderBook->bidPrice() : orderBook->askPrice();
+
+    if (LimitOrderChaser::leftInterval(ord, target)) {
+        bool reduce = ord.reduce;
+        cancelActiveLimitOrder();
+
+        if (reduce) {
+            placeMarketOrder(Order(-position->qty, true));
         }
+    } else if (auto price = chaser.chase(ord, target, steady_clock::now())) {
+        ord.price = *price;
+        amendLimitOrder(ord);
+    } else if (chaser.hasPendingAmend()) {
+        startChaseTimer();
+    }
+
+    return false;
+}
+
+// The stop loss lives on the exchange, so it also protects the position while we are slow or disconnected.
+// checkStopLoss stays as a fallback, its market order is reduce only so it can't flip the position.
+void Bybit::syncExchangeStopLoss() {
+    if (position->qty == 0) {
+        requestedStopLossPrice = 0;  // the exchange drops the stop loss with the position
+        return;
+    }
+
+    double stopLossPrice = std::round(position->stopLossPrice / tickSize) * tickSize;
+
+    if (stopLossPrice == requestedStopLossPrice || orderGateway->isInFlight(tradingStopHandle)) {
+        return;
     }
 
-    // Stop Loss
-    if (position->qty != 0) {
+    Order ord;
+    ord.price = stopLossPrice;
+    requestedStopLossPrice = stopLossPrice;
+    tradingStopHandle
+        = orderGateway->submitTradingStop(ord, [this](const OrderReport &report) { onOrderReport(report); });
+}
+
+bool Bybit::checkStopLoss() {
+    if (position->qty != 0 && !orderBook->isEmpty() && !orderGateway->isInFlight(marketOrderHandle)) {
         double midPrice = (orderBook->askPrice() + orderBook->bidPrice()) / 2;
         if ((position->isLong() && midPrice < position->stopLossPrice)
             || (position->isShort() && midPrice > position->stopLossPrice)) {
@@ -675,20 +1429,16 @@ void Bybit::doAutomatedTrading() {
                 cancelActiveLimitOrder();
             }
             placeMarketOrder(Order(-position->qty, true));
-            spdlog::info("Stop Loss triggered at {}", position->stopLossPrice);
+            BYTRA_LOG_INFO("Stop Loss triggered at {}", position->stopLossPrice);
+            return true;
         }
     }
+
+    return false;
 }
 
 void Bybit::removeUnusedCandles() {
-    int factor = 4;
-
-    for (auto const &[tf, vec] : candles) {
-        if (vec.size() >= tf.amount * factor) {
-            auto first = vec.end() - tf.amount;
-            auto last = vec.end();
-            std::vector<std::shared_ptr<Candle>> new_vec(first, last);
-            candles[tf] = new_vec;
-        }
+    for (auto &[tf, vec] : candles) {
+        trimCandles(vec, tf.amount);
     }
 }
@@ -10,15 +10,32 @@
 
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/beast/websocket/stream.hpp>
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Candle.h"
+#include "ClockSync.h"
+#include "HmacSigner.h"
+#include "HttpSessionPool.h"
+#include "LatencyStats.h"
+#include "LimitOrderChaser.h"
+#include "MarketDataParser.h"
+#include "Metrics.h"
 #include "OrderBook.h"
+#include "OrderGateway.h"
+#include "OrderManager.h"
+#include "RateLimiter.h"
+#include "RequestBuilder.h"
 #include "Position.h"
+#include "TopicTable.h"
+#include "TradingEvent.h"
 #include "strategies/Strategy.h"
 
 namespace beast = boost::beast;          // from <boost/beast.hpp>
@@ -34,15 +51,158 @@ class Bybit {
     std::string websocketHost;
     std::string websocketTarget;
     beast::flat_buffer websocketBuffer;
+    dom::parser websocketParser;
+    std::unique_ptr<MarketDataParser> marketDataParser;
+    TopicTable<void (Bybit::*)(const dom::element &)> websocketTopics;
     std::string apiKey;
-    std::string apiSecret;
+    std::unique_ptr<HmacSigner> signer;
+    std::unique_ptr<HttpSessionPool> httpSessions;
     std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> candles;
     std::vector<std::string> allowedTimeframes = {"1", "3", "5", "15", "30", "60", "120", "240", "360", "D", "W", "M"};
     std::shared_ptr<websocket::stream<ssl::stream<tcp::socket>>> websocket;
+    std::deque<std::string> websocketWriteQueue;
+    std::unique_ptr<net::steady_timer> heartbeatTimer;
+    std::unique_ptr<net::steady_timer> orderBookSyncTimer;
+    std::unique_ptr<net::steady_timer> stopLossTimer;
+    std::unique_ptr<net::steady_timer> candleCloseTimer;
+    std::unique_ptr<net::steady_timer> chaseTimer;
+    std::unique_ptr<net::steady_timer> latencyReportTimer;
+    std::chrono::seconds latencyReportInterval{0};
+    std::unique_ptr<LatencyStats> latency;
+    std::shared_ptr<Metrics> metrics;
+    Metrics::Counter *websocketMessages = nullptr;
+    Metrics::Counter *websocketConnects = nullptr;
+    Metrics::Counter *orderBookResyncs = nullptr;
+    Metrics::Counter *orderRequestFailures = nullptr;
+    Metrics::Gauge *workingOrders = nullptr;
+    Metrics::Gauge *orderBacklog = nullptr;
+    Metrics::Gauge *positionQty = nullptr;
+
+    struct RestMetrics {
+        Metrics::Counter *requests = nullptr;
+        Metrics::Counter *errors = nullptr;
+        Metrics::Counter *rateLimited = nullptr;
+        std::unordered_map<int, Metrics::Counter *> apiErrors;  // the ret_codes that are part of normal trading
+    };
+
+    std::unordered_map<std::string, RestMetrics> restEndpointMetrics;  // fixed after construction
+    std::chrono::steady_clock::time_point triggerTime;  // arrival of the frame or timer the trading pass acts on
+    LimitOrderChaser chaser;
+    size_t maxBatchSize = 1;
+    std::chrono::microseconds batchLatencyBudget{0};
+    size_t batchSize = 0;
+    std::chrono::steady_clock::time_point batchStart;
     std::shared_ptr<Position> position;
     std::shared_ptr<Strategy> strategy;
     std::shared_ptr<OrderBook> orderBook;
-    bool newCandleAdded = true;
+    unsigned pendingEvents = CandleClosed | PositionChanged;
+    double lastBidPrice = 0;
+    double lastAskPrice = 0;
+    std::unique_ptr<ClockSync> clockSync;
+    std::unique_ptr<RateLimiter> rateLimiter;  // reads clockSync, so destroyed before it
+    // Its executor thread uses the members above, so it is destroyed, and the thread joined, before them
+    std::unique_ptr<OrderGateway> orderGateway;
+    std::unique_ptr<OrderManager> orderManager;
+    std::chrono::milliseconds recvWindow{1000};  // how long after its timestamp a signed request is accepted
+    OrderHandle marketOrderHandle = 0;
+    OrderHandle tradingStopHandle = 0;
+    double requestedStopLossPrice = 0;  // last stop loss sent to the exchange
+    double tickSize = 0.5;
+    Order preparedLongEntry;
+    Order preparedShortEntry;
+    Order preparedExit;
+    std::vector<std::shared_ptr<Candle>> *signalCandles = nullptr;  // candles of the strategy's first timeframe
+    seconds signalInterval{0};
+    TriggerLevels triggerLevels;
+    bool triggerLevelsReady = false;
+    long triggerLevelsTimestamp = 0;  // last candle the trigger levels were computed from
+    long decidedCandleTimestamp = 0;  // candle whose signals were already acted upon at its close
+    bool boundaryDecisions = false;
+
+    struct Signals {
+        bool exit = false;
+        bool longEntry = false;
+        bool shortEntry = false;
+    };
+
+    void onWebsocketRead(const beast::error_code &ec);
+
+    void writeWebsocket(std::string msg);
+
+    void onWebsocketWrite(const beast::error_code &ec);
+
+    bool isWebsocketDataAvailable();
+
+    void startHeartbeatTimer();
+
+    void startOrderBookSyncTimer();
+
+    void startStopLossTimer();
+
+    void startCandleCloseTimer();
+
+    void startChaseTimer();
+
+    void startLatencyReportTimer();
+
+    void registerMetrics(const std::vector<std::string> &endpoints);
+
+    void updateOrderGauges();
+
+    void checkApiResponse(const std::string &endpoint, const cpr::Response &r,
+                          const std::chrono::steady_clock::time_point &start);
+
+    // ret_code of a parsed private response, non-zero codes are counted per endpoint and code. The rate limit in
+    // the body is handed to the rate limiter.
+    int checkPrivateResponse(const std::string &endpoint, const dom::element &response);
+
+    void cancelTimers();
+
+    void addCandle(const std::string_view &interval, const Candle &candle);
+
+    void parsePositionMsg(const dom::element &response);
+
+    void parseOrderMsg(const dom::element &response);
+
+    void parseKlineMsg(const dom::element &response);
+
+    void parseOrderBookMsg(const dom::element &response);
+
+    void processOrderReports();
+
+    void onOrderReport(const OrderReport &report);
+
+    void dropActiveOrder();
+
+    Order prepareOrder(Order ord);
+
+    void prepareOrders();
+
+    Signals evaluateSignals(const double &close, const bool &useTriggerLevels);
+
+    bool placeSignalOrders(const Signals &signals);
+
+    void updateTriggerLevels();
+
+    void decideAtCandleClose();
+
+    bool checkSignals();
+
+    bool chaseActiveOrder();
+
+    OrderReport executeOrderRequest(const OrderRequest &request);
+
+    OrderReport sendMarketOrder(const Order &ord);
+
+    OrderReport sendLimitOrder(const Order &ord);
+
+    OrderReport sendAmendLimitOrder(const Order &ord);
+
+    OrderReport sendCancelLimitOrder(const Order &ord);
+
+    OrderReport sendTradingStop(const Order &ord);
+
+    void syncExchangeStopLoss();
 
   public:
     Bybit(std::string &baseUrl, std::string &apiKey, std::string &apiSecret, std::string &websocketHost,
@@ -52,6 +212,10 @@ class Bybit {
 
     cpr::Response ApiPost(const cpr::Payload &payload, const std::string &endpoint);
 
+    cpr::Response ApiGet(const std::string_view &query, const std::string &endpoint);
+
+    cpr::Response ApiPost(const std::string_view &body, const std::string &endpoint);
+
     void loadCandles();
 
     void loadPosition();
@@ -66,7 +230,30 @@ class Bybit {
 
     void readWebsocket();
 
-    void parseWebsocketMsg(const std::string &msg);
+    // Frames that are already available are applied in batches of at most maxBatchSize before a trading pass,
+    // as long as the batch stays within the latency budget. A batch size of 1 trades after every frame.
+    void setIngestBatching(const size_t &maxBatchSize, const std::chrono::microseconds &batchLatencyBudget);
+
+    // Act on the strategy's trigger levels as soon as a candle of its first timeframe closes, with the middle
+    // of the book as close price, instead of waiting for the confirmed candle
+    void setBoundaryDecisions(const bool &enabled);
+
+    void setChasing(const LimitOrderChaser::Settings &settings);
+
+    // Signed requests are rejected when they reach the exchange more than recvWindow after their timestamp
+    void setRecvWindow(const std::chrono::milliseconds &window);
+
+    [[nodiscard]] const ClockSync &getClockSync() const;
+
+    // Logs the latency percentiles of every stage each interval, zero disables the report
+    void setLatencyReportInterval(const std::chrono::seconds &interval);
+
+    LatencyStats &getLatencyStats();
+
+    [[nodiscard]] std::shared_ptr<Metrics> getMetrics() const;
+
+    // buf must be followed by SIMDJSON_PADDING readable bytes
+    void parseWebsocketMsg(const uint8_t *buf, const size_t &len);
 
     void sendWebsocketHeartbeat();
 
@@ -80,8 +267,11 @@ class Bybit {
 
     void cancelActiveLimitOrder();
 
+    // Runs the trading logic subscribed to the events that happened since the last pass
     void doAutomatedTrading();
 
+    bool checkStopLoss();
+
     void removeUnusedCandles();
 };
 
@@ -0,0 +1,25 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_BYBITREQUESTS_H
+#define BYTRA_BYBITREQUESTS_H
+
+#include "RequestBuilder.h"
+
+// Fields of the signed private requests, in the order they are serialized and signed
+inline constexpr RequestTemplate<4> positionListRequest({"api_key", "recv_window", "symbol", "timestamp"});
+inline constexpr RequestTemplate<4> cancelAllRequest({"api_key", "recv_window", "symbol", "timestamp"});
+inline constexpr RequestTemplate<10> marketOrderRequest({"api_key", "order_link_id", "order_type", "qty",
+                                                         "recv_window", "reduce_only", "side", "symbol",
+                                                         "time_in_force", "timestamp"});
+inline constexpr RequestTemplate<11> limitOrderRequest({"api_key", "order_link_id", "order_type", "price", "qty",
+                                                        "recv_window", "reduce_only", "side", "symbol",
+                                                        "time_in_force", "timestamp"});
+inline constexpr RequestTemplate<6> replaceOrderRequest({"api_key", "order_id", "p_r_price", "recv_window", "symbol",
+                                                         "timestamp"});
+inline constexpr RequestTemplate<5> cancelOrderRequest({"api_key", "order_id", "recv_window", "symbol", "timestamp"});
+inline constexpr RequestTemplate<6> tradingStopRequest({"api_key", "recv_window", "sl_trigger_by", "stop_loss",
+                                                        "symbol", "timestamp"});
+
+#endif  // BYTRA_BYBITREQUESTS_H
@@ -5,7 +5,9 @@
 #ifndef MEXTRA_CANDLE_H
 #define MEXTRA_CANDLE_H
 
+#include <memory>
 #include <string>
+#include <vector>
 
 struct TimeFrame {
     int ticks;  // 1 tick = 1 minute
@@ -39,4 +41,11 @@ struct Candle {
     long timestamp;
 };
 
+// Keeps the last amount candles once factor times as many piled up, erasing in place keeps the capacity
+inline void trimCandles(std::vector<std::shared_ptr<Candle>>& candles, const long& amount, const long& factor = 4) {
+    if (candles.size() >= static_cast<size_t>(amount * factor)) {
+        candles.erase(candles.begin(), candles.end() - amount);
+    }
+}
+
 #endif  // MEXTRA_CANDLE_H
@@ -0,0 +1,105 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "ClockSync.h"
+
+#include <simdjson.h>
+
+#include <cstdlib>
+
+#include "AsyncLogger.h"
+
+using namespace std::chrono;
+
+ClockSync::ClockSync(HttpSessionPool &sessions, std::string endpoint, const seconds &interval,
+                     const size_t &filterSize)
+    : sessions(sessions), endpoint(std::move(endpoint)), interval(interval), filter(filterSize) {
+    // A short burst fills the filter, so the first signed request already uses a good estimate
+    synchronize(static_cast<int>(filterSize / 2));
+    thread = std::thread(&ClockSync::run, this);
+}
+
+ClockSync::~ClockSync() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    stopCondition.notify_all();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+std::optional<ClockFilter::Sample> ClockSync::sample() {
+    thread_local simdjson::dom::parser parser;
+
+    auto localStart = system_clock::now();
+    auto start = steady_clock::now();
+    cpr::Response r = sessions.get(endpoint, cpr::Parameters{});
+    auto rtt = duration_cast<microseconds>(steady_clock::now() - start);
+
+    if (r.status_code != 200) {
+        BYTRA_LOG_WARN("ClockSync - server time request failed - {}", r.status_code);
+        return std::nullopt;
+    }
+
+    std::string_view timeNow;
+
+    if (parser.parse(r.text)["time_now"].get(timeNow)) {
+        BYTRA_LOG_WARN("ClockSync - invalid server time response");
+        return std::nullopt;
+    }
+
+    auto serverTime = parseServerTime(timeNow);
+
+    if (!serverTime) {
+        BYTRA_LOG_WARN("ClockSync - invalid server time {}", timeNow);
+        return std::nullopt;
+    }
+
+    // The server read its clock somewhere during the round trip, halfway is the best guess
+    auto localTime = duration_cast<microseconds>(localStart.time_since_epoch()) + rtt / 2;
+    return ClockFilter::Sample{*serverTime - localTime, rtt};
+}
+
+void ClockSync::synchronize(const int &samples) {
+    for (int i = 0; i < samples; i++) {
+        if (auto s = sample()) {
+            filter.add(*s);
+        }
+    }
+
+    if (filter.empty()) {
+        return;
+    }
+
+    ClockFilter::Sample best = filter.best();
+    offsetUs = best.offset.count();
+    rttUs = best.rtt.count();
+
+    BYTRA_LOG_DEBUG("ClockSync - offset {} us, rtt {} us", best.offset.count(), best.rtt.count());
+
+    if (std::abs(best.offset.count()) > duration_cast<microseconds>(milliseconds(500)).count()) {
+        BYTRA_LOG_WARN("ClockSync - local clock is {} ms off", best.offset.count() / 1000);
+    }
+}
+
+void ClockSync::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (!stopCondition.wait_for(lock, interval, [this] { return stopping; })) {
+        lock.unlock();
+        synchronize(1);
+        lock.lock();
+    }
+}
+
+system_clock::time_point ClockSync::now() const { return system_clock::now() + offset(); }
+
+long ClockSync::timestamp() const { return duration_cast<milliseconds>(now().time_since_epoch()).count(); }
+
+microseconds ClockSync::offset() const { return microseconds(offsetUs.load()); }
+
+microseconds ClockSync::rtt() const { return microseconds(rttUs.load()); }
@@ -0,0 +1,66 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_CLOCKSYNC_H
+#define BYTRA_CLOCKSYNC_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "HttpSessionPool.h"
+#include "ServerTime.h"
+
+/** Tracks the offset between the local clock and the exchange clock
+ * The server time endpoint is sampled in the background, the local time halfway the round trip is compared
+ * with the time in the response. Timestamps of signed requests are taken from the corrected clock so they
+ * can use a tight recv_window. Without a successful sample the local clock is used as is.
+ * */
+class ClockSync {
+  private:
+    HttpSessionPool &sessions;
+    std::string endpoint;
+    std::chrono::seconds interval;
+    ClockFilter filter;  // only used by the sampling thread, after the first synchronization
+    std::atomic<long> offsetUs{0};
+    std::atomic<long> rttUs{0};
+    std::mutex mutex;
+    std::condition_variable stopCondition;
+    bool stopping = false;
+    std::thread thread;
+
+    std::optional<ClockFilter::Sample> sample();
+
+    void synchronize(const int &samples);
+
+    void run();
+
+  public:
+    ClockSync(HttpSessionPool &sessions, std::string endpoint,
+              const std::chrono::seconds &interval = std::chrono::seconds(60), const size_t &filterSize = 8);
+
+    ~ClockSync();
+
+    ClockSync(const ClockSync &) = delete;
+
+    ClockSync &operator=(const ClockSync &) = delete;
+
+    // Estimated server time
+    [[nodiscard]] std::chrono::system_clock::time_point now() const;
+
+    // Estimated server time in milliseconds since the epoch, as used in signed requests
+    [[nodiscard]] long timestamp() const;
+
+    // Server clock minus local clock
+    [[nodiscard]] std::chrono::microseconds offset() const;
+
+    // Round trip of the sample the offset was taken from
+    [[nodiscard]] std::chrono::microseconds rtt() const;
+};
+
+#endif  // BYTRA_CLOCKSYNC_H
@@ -0,0 +1,110 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "HmacSigner.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdexcept>
+
+#include "AsyncLogger.h"
+
+namespace {
+    constexpr size_t blockSize = 64;  // SHA-256 block size
+    constexpr size_t digestSize = 32;
+
+    constexpr std::array<char, 512> makeHexTable() {
+        constexpr char digits[] = "0123456789abcdef";
+        std::array<char, 512> table{};
+
+        for (size_t i = 0; i < 256; i++) {
+            table[2 * i] = digits[i >> 4];
+            table[2 * i + 1] = digits[i & 0xf];
+        }
+
+        return table;
+    }
+
+    constexpr std::array<char, 512> hexTable = makeHexTable();
+
+    struct MdCtxDeleter {
+        void operator()(EVP_MD_CTX *ctx) const { EVP_MD_CTX_free(ctx); }
+    };
+
+    // Scratch context the keyed states are cloned into, one per thread so signing needs no lock
+    EVP_MD_CTX *scratchContext() {
+        thread_local std::unique_ptr<EVP_MD_CTX, MdCtxDeleter> ctx(EVP_MD_CTX_new());
+        return ctx.get();
+    }
+
+    EVP_MD_CTX *newKeyedState(const unsigned char *key, const unsigned char &pad) {
+        unsigned char block[blockSize];
+
+        for (size_t i = 0; i < blockSize; i++) {
+            block[i] = key[i] ^ pad;
+        }
+
+        EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+
+        if (ctx == nullptr || EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr) != 1
+            || EVP_DigestUpdate(ctx, block, blockSize) != 1) {
+            EVP_MD_CTX_free(ctx);
+            BYTRA_LOG_ERROR("HmacSigner - failed to initialize SHA-256 state");
+            throw std::runtime_error("Failed to initialize SHA-256 state.");
+        }
+
+        return ctx;
+    }
+}  // namespace
+
+HmacSigner::HmacSigner(const std::string &secret) {
+    // Keys longer than a block are hashed first, shorter keys are padded with zeros
+    unsigned char key[blockSize] = {};
+
+    if (secret.size() > blockSize) {
+        unsigned int len;
+        EVP_Digest(secret.data(), secret.size(), key, &len, EVP_sha256(), nullptr);
+    } else {
+        std::copy(secret.begin(), secret.end(), key);
+    }
+
+    innerState = newKeyedState(key, 0x36);
+
+    try {
+        outerState = newKeyedState(key, 0x5c);
+    } catch (...) {
+        EVP_MD_CTX_free(innerState);
+        throw;
+    }
+}
+
+HmacSigner::~HmacSigner() {
+    EVP_MD_CTX_free(innerState);
+    EVP_MD_CTX_free(outerState);
+}
+
+void HmacSigner::sign(const std::string_view &message, char *out) const {
+    EVP_MD_CTX *ctx = scratchContext();
+    unsigned char digest[digestSize];
+
+    if (ctx == nullptr || EVP_MD_CTX_copy_ex(ctx, innerState) != 1
+        || EVP_DigestUpdate(ctx, message.data(), message.size()) != 1
+        || EVP_DigestFinal_ex(ctx, digest, nullptr) != 1 || EVP_MD_CTX_copy_ex(ctx, outerState) != 1
+        || EVP_DigestUpdate(ctx, digest, digestSize) != 1 || EVP_DigestFinal_ex(ctx, digest, nullptr) != 1) {
+        BYTRA_LOG_ERROR("HmacSigner::sign - SHA-256 failed");
+        throw std::runtime_error("Failed to sign message.");
+    }
+
+    for (size_t i = 0; i < digestSize; i++) {
+        out[2 * i] = hexTable[2 * digest[i]];
+        out[2 * i + 1] = hexTable[2 * digest[i] + 1];
+    }
+}
+
+std::string HmacSigner::sign(const std::string_view &message) const {
+    std::string signature(signatureLength, '\0');
+    sign(message, signature.data());
+    return signature;
+}
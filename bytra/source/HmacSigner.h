@@ -0,0 +1,42 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_HMACSIGNER_H
+#define BYTRA_HMACSIGNER_H
+
+#include <openssl/evp.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/** HMAC-SHA256 signer for a fixed secret
+ * The SHA-256 states after absorbing the inner (key ^ ipad) and outer (key ^ opad) blocks are computed once,
+ * a signature only clones them and hashes the message and the inner digest.
+ * sign may be called from several threads at once.
+ * */
+class HmacSigner {
+  private:
+    EVP_MD_CTX *innerState = nullptr;
+    EVP_MD_CTX *outerState = nullptr;
+
+  public:
+    // Length of a signature in hex characters
+    static constexpr size_t signatureLength = 64;
+
+    explicit HmacSigner(const std::string &secret);
+
+    ~HmacSigner();
+
+    HmacSigner(const HmacSigner &) = delete;
+
+    HmacSigner &operator=(const HmacSigner &) = delete;
+
+    // Writes signatureLength lowercase hex characters to out, no null terminator is added
+    void sign(const std::string_view &message, char *out) const;
+
+    std::string sign(const std::string_view &message) const;
+};
+
+#endif  // BYTRA_HMACSIGNER_H
@@ -0,0 +1,188 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "HttpSessionPool.h"
+
+#include "AsyncLogger.h"
+
+using namespace std::chrono;
+
+HttpSessionPool::HttpSessionPool(std::string baseUrl, std::string pingEndpoint, const size_t &size,
+                                 const seconds &keepAliveInterval) {
+    this->baseUrl = std::move(baseUrl);
+    this->pingEndpoint = std::move(pingEndpoint);
+    this->keepAliveInterval = keepAliveInterval;
+
+    for (size_t i = 0; i < size; i++) {
+        idleSessions.push_back({std::make_unique<cpr::Session>(), steady_clock::now()});
+    }
+
+    keepAliveThread = std::thread(&HttpSessionPool::keepAlive, this);
+}
+
+HttpSessionPool::~HttpSessionPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    stopCondition.notify_all();
+
+    if (keepAliveThread.joinable()) {
+        keepAliveThread.join();
+    }
+}
+
+HttpSessionPool::PooledSession HttpSessionPool::acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (idleSessions.empty()) {
+        // Every session is busy, grow the pool instead of waiting
+        return {std::make_unique<cpr::Session>(), steady_clock::now()};
+    }
+
+    // Most recently used session first, it is the most likely to still be connected
+    PooledSession pooled = std::move(idleSessions.back());
+    idleSessions.pop_back();
+    return pooled;
+}
+
+void HttpSessionPool::release(PooledSession pooled) {
+    pooled.lastUsed = steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    idleSessions.push_back(std::move(pooled));
+}
+
+bool HttpSessionPool::isTransportError(const cpr::Response &r) {
+    return r.error.code != cpr::ErrorCode::OK || r.status_code == 0;
+}
+
+void HttpSessionPool::preconnect() {
+    std::vector<PooledSession> sessions;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sessions.swap(idleSessions);
+    }
+
+    for (auto &pooled : sessions) {
+        pooled.session->SetUrl(cpr::Url{baseUrl + pingEndpoint});
+        pooled.session->SetParameters(cpr::Parameters{});
+        cpr::Response r = pooled.session->Get();
+
+        if (isTransportError(r)) {
+            BYTRA_LOG_ERROR("HttpSessionPool::preconnect - {}", r.error.message);
+            pooled.session = std::make_unique<cpr::Session>();
+        }
+
+        release(std::move(pooled));
+    }
+}
+
+cpr::Response HttpSessionPool::get(const std::string &endpoint, const cpr::Parameters &parameters) {
+    PooledSession pooled = acquire();
+    pooled.session->SetUrl(cpr::Url{baseUrl + endpoint});
+    pooled.session->SetParameters(parameters);
+    cpr::Response r = pooled.session->Get();
+
+    if (isTransportError(r)) {
+        // The kept-alive connection was dropped, GET requests are safe to send again on a new session
+        BYTRA_LOG_WARN("HttpSessionPool::get - replacing session - {}", r.error.message);
+        pooled.session = std::make_unique<cpr::Session>();
+        pooled.session->SetUrl(cpr::Url{baseUrl + endpoint});
+        pooled.session->SetParameters(parameters);
+        r = pooled.session->Get();
+    }
+
+    release(std::move(pooled));
+    return r;
+}
+
+cpr::Response HttpSessionPool::post(const std::string &endpoint, const cpr::Payload &payload) {
+    PooledSession pooled = acquire();
+    pooled.session->SetUrl(cpr::Url{baseUrl + endpoint});
+    pooled.session->SetParameters(cpr::Parameters{});
+    pooled.session->SetPayload(payload);
+    cpr::Response r = pooled.session->Post();
+
+    if (isTransportError(r)) {
+        // POST requests are not retried, the order might have reached the exchange
+        BYTRA_LOG_WARN("HttpSessionPool::post - replacing session - {}", r.error.message);
+        pooled.session = std::make_unique<cpr::Session>();
+    }
+
+    release(std::move(pooled));
+    return r;
+}
+
+cpr::Response HttpSessionPool::get(const std::string &endpoint, const std::string_view &query) {
+    cpr::Url url{baseUrl + endpoint + "?"};
+    url.append(query);
+
+    PooledSession pooled = acquire();
+    pooled.session->SetUrl(url);
+    pooled.session->SetParameters(cpr::Parameters{});
+    cpr::Response r = pooled.session->Get();
+
+    if (isTransportError(r)) {
+        BYTRA_LOG_WARN("HttpSessionPool::get - replacing session - {}", r.error.message);
+        pooled.session = std::make_unique<cpr::Session>();
+        pooled.session->SetUrl(url);
+        r = pooled.session->Get();
+    }
+
+    release(std::move(pooled));
+    return r;
+}
+
+cpr::Response HttpSessionPool::post(const std::string &endpoint, const std::string_view &body) {
+    PooledSession pooled = acquire();
+    pooled.session->SetUrl(cpr::Url{baseUrl + endpoint});
+    pooled.session->SetParameters(cpr::Parameters{});
+    pooled.session->SetBody(cpr::Body(body.data(), body.size()));
+    cpr::Response r = pooled.session->Post();
+
+    if (isTransportError(r)) {
+        BYTRA_LOG_WARN("HttpSessionPool::post - replacing session - {}", r.error.message);
+        pooled.session = std::make_unique<cpr::Session>();
+    }
+
+    release(std::move(pooled));
+    return r;
+}
+
+void HttpSessionPool::keepAlive() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (!stopCondition.wait_for(lock, keepAliveInterval, [this] { return stopping; })) {
+        // Take the sessions that have been idle for too long out of the pool, so nobody else uses them
+        std::vector<PooledSession> staleSessions;
+        auto now = steady_clock::now();
+
+        for (auto it = idleSessions.begin(); it != idleSessions.end();) {
+            if (now - it->lastUsed >= keepAliveInterval) {
+                staleSessions.push_back(std::move(*it));
+                it = idleSessions.erase(it);
+            } else {
+                it++;
+            }
+        }
+
+        lock.unlock();
+
+        for (auto &pooled : staleSessions) {
+            pooled.session->SetUrl(cpr::Url{baseUrl + pingEndpoint});
+            pooled.session->SetParameters(cpr::Parameters{});
+            cpr::Response r = pooled.session->Get();
+
+            if (isTransportError(r)) {
+                BYTRA_LOG_WARN("HttpSessionPool::keepAlive - replacing session - {}", r.error.message);
+                pooled.session = std::make_unique<cpr::Session>();
+            }
+
+            release(std::move(pooled));
+        }
+
+        lock.lock();
+    }
+}
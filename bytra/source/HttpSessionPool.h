@@ -0,0 +1,71 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_HTTPSESSIONPOOL_H
+#define BYTRA_HTTPSESSIONPOOL_H
+
+#include <cpr/cpr.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/** Pool of long-lived HTTPS sessions to the API host
+ * A cpr::Session keeps its connection open between requests, so reusing one saves the DNS lookup
+ * and the TCP and TLS handshakes on every call. Sessions are connected up front, idle sessions are
+ * pinged in the background so the connection stays warm, and a session that hits a transport error
+ * is replaced by a fresh one.
+ * */
+class HttpSessionPool {
+  private:
+    struct PooledSession {
+        std::unique_ptr<cpr::Session> session;
+        std::chrono::steady_clock::time_point lastUsed;
+    };
+
+    std::string baseUrl;
+    std::string pingEndpoint;
+    std::chrono::seconds keepAliveInterval;
+    std::vector<PooledSession> idleSessions;
+    std::mutex mutex;
+    std::condition_variable stopCondition;
+    bool stopping = false;
+    std::thread keepAliveThread;
+
+    PooledSession acquire();
+
+    void release(PooledSession pooled);
+
+    static bool isTransportError(const cpr::Response &r);
+
+    void keepAlive();
+
+  public:
+    HttpSessionPool(std::string baseUrl, std::string pingEndpoint, const size_t &size,
+                    const std::chrono::seconds &keepAliveInterval = std::chrono::seconds(30));
+
+    ~HttpSessionPool();
+
+    HttpSessionPool(const HttpSessionPool &) = delete;
+
+    HttpSessionPool &operator=(const HttpSessionPool &) = delete;
+
+    void preconnect();
+
+    cpr::Response get(const std::string &endpoint, const cpr::Parameters &parameters);
+
+    cpr::Response post(const std::string &endpoint, const cpr::Payload &payload);
+
+    // query and body are sent as they are, they have to be URL encoded already
+    cpr::Response get(const std::string &endpoint, const std::string_view &query);
+
+    cpr::Response post(const std::string &endpoint, const std::string_view &body);
+};
+
+#endif  // BYTRA_HTTPSESSIONPOOL_H
@@ -0,0 +1,115 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "LatencyStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "AsyncLogger.h"
+
+uint64_t LatencyHistogram::bucketValue(const size_t &index) {
+    constexpr uint64_t linear = uint64_t(1) << subBucketBits;
+
+    if (index < linear) {
+        return index;
+    }
+
+    size_t shift = (index - linear) / (linear / 2) + 1;
+    uint64_t subBucket = (index - linear) % (linear / 2) + linear / 2;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+uint64_t LatencyHistogram::Snapshot::percentile(const double &percentile) const {
+    if (total == 0) {
+        return 0;
+    }
+
+    auto rank = static_cast<uint64_t>(std::ceil(percentile / 100 * static_cast<double>(total)));
+    rank = std::clamp<uint64_t>(rank, 1, total);
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+
+        if (seen >= rank) {
+            return std::min(bucketValue(i), max);
+        }
+    }
+
+    return max;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot(const bool &reset) {
+    Snapshot snapshot;
+    snapshot.counts.resize(bucketCount);
+
+    for (size_t i = 0; i < bucketCount; i++) {
+        snapshot.counts[i] = reset ? counts[i].exchange(0, std::memory_order_relaxed)
+                                   : counts[i].load(std::memory_order_relaxed);
+        snapshot.total += snapshot.counts[i];
+    }
+
+    snapshot.max = reset ? max.exchange(0, std::memory_order_relaxed) : max.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+LatencyStats::LatencyStats(const std::vector<std::string> &endpoints) {
+    for (const auto &endpoint : endpoints) {
+        this->endpoints[endpoint] = std::make_unique<LatencyHistogram>();
+    }
+}
+
+const char *LatencyStats::stageName(const LatencyStage &stage) {
+    switch (stage) {
+        case LatencyStage::Parse:
+            return "parse";
+        case LatencyStage::Strategy:
+            return "strategy";
+        case LatencyStage::TickToOrder:
+            return "tick_to_order";
+        case LatencyStage::Queue:
+            return "queue";
+        case LatencyStage::Sign:
+            return "sign";
+        case LatencyStage::Count:
+            break;
+    }
+
+    return "unknown";
+}
+
+void LatencyStats::record(const std::string &endpoint, const std::chrono::steady_clock::time_point &start) {
+    auto it = endpoints.find(endpoint);
+
+    if (it != endpoints.end()) {
+        it->second->record(std::chrono::steady_clock::now() - start);
+    }
+}
+
+std::vector<std::pair<std::string, LatencyHistogram::Snapshot>> LatencyStats::snapshot(const bool &reset) {
+    std::vector<std::pair<std::string, LatencyHistogram::Snapshot>> snapshots;
+
+    for (size_t i = 0; i < stages.size(); i++) {
+        snapshots.emplace_back(stageName(static_cast<LatencyStage>(i)), stages[i].snapshot(reset));
+    }
+
+    for (auto &[endpoint, histogram] : endpoints) {
+        snapshots.emplace_back(endpoint, histogram->snapshot(reset));
+    }
+
+    return snapshots;
+}
+
+void LatencyStats::log(const bool &reset) {
+    for (const auto &[name, snapshot] : snapshot(reset)) {
+        if (snapshot.total == 0) {
+            continue;
+        }
+
+        BYTRA_LOG_INFO("[Latency] {} - n {} p50 {:.1f} us p99 {:.1f} us p99.9 {:.1f} us max {:.1f} us", name,
+                        snapshot.total, snapshot.percentile(50) / 1e3, snapshot.percentile(99) / 1e3,
+                        snapshot.percentile(99.9) / 1e3, snapshot.max / 1e3);
+    }
+}
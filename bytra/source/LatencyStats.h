@@ -0,0 +1,103 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_LATENCYSTATS_H
+#define BYTRA_LATENCYSTATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/** Histogram of durations in nanoseconds with a relative error of at most 1/64 (1.6%), like an HDR histogram
+ * Values below 128 ns get a bucket each, every power of two above that is split in 64 buckets. Recording is a
+ * relaxed increment of one counter, so any thread can record without a lock. Values above 68 s are clamped.
+ * */
+class LatencyHistogram {
+  public:
+    static constexpr int subBucketBits = 7;
+    static constexpr int maxValueBits = 36;
+    static constexpr uint64_t maxValue = (uint64_t(1) << maxValueBits) - 1;
+    static constexpr size_t bucketCount
+        = (size_t(1) << subBucketBits) + (maxValueBits - subBucketBits) * (size_t(1) << (subBucketBits - 1));
+
+    struct Snapshot {
+        std::vector<uint64_t> counts;
+        uint64_t total = 0;
+        uint64_t max = 0;
+
+        // Smallest value that percentile percent of the recorded values are at or below, in nanoseconds
+        [[nodiscard]] uint64_t percentile(const double &percentile) const;
+    };
+
+  private:
+    std::array<std::atomic<uint64_t>, bucketCount> counts{};
+    std::atomic<uint64_t> max{0};
+
+  public:
+    static size_t bucketIndex(uint64_t value) {
+        constexpr uint64_t linear = uint64_t(1) << subBucketBits;
+        value = value > maxValue ? maxValue : value;
+
+        if (value < linear) {
+            return value;
+        }
+
+        int shift = 63 - __builtin_clzll(value) - (subBucketBits - 1);
+        return linear + (shift - 1) * (linear / 2) + ((value >> shift) - linear / 2);
+    }
+
+    // Largest value that falls in the bucket
+    static uint64_t bucketValue(const size_t &index);
+
+    void record(const std::chrono::nanoseconds &duration) {
+        auto value = static_cast<uint64_t>(duration.count() > 0 ? duration.count() : 0);
+        counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+
+        // The maximum rarely changes, most calls only load it
+        uint64_t current = max.load(std::memory_order_relaxed);
+        while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Counts of values recorded by other threads may be missing, when reset they are kept for the next snapshot
+    Snapshot snapshot(const bool &reset = false);
+};
+
+// Stages of the path from a websocket frame to an order on the exchange
+enum class LatencyStage { Parse, Strategy, TickToOrder, Queue, Sign, Count };
+
+/** Latency histograms of the trading path, one per stage and one per REST endpoint
+ * The endpoints are fixed when constructed, so the histograms are looked up without a lock.
+ * */
+class LatencyStats {
+  private:
+    std::array<LatencyHistogram, static_cast<size_t>(LatencyStage::Count)> stages;
+    std::unordered_map<std::string, std::unique_ptr<LatencyHistogram>> endpoints;
+
+  public:
+    explicit LatencyStats(const std::vector<std::string> &endpoints);
+
+    static const char *stageName(const LatencyStage &stage);
+
+    void record(const LatencyStage &stage, const std::chrono::steady_clock::time_point &start) {
+        stages[static_cast<size_t>(stage)].record(std::chrono::steady_clock::now() - start);
+    }
+
+    // Round trip of a REST request, endpoints that were not registered are ignored
+    void record(const std::string &endpoint, const std::chrono::steady_clock::time_point &start);
+
+    // Snapshot of every histogram, named after its stage or endpoint
+    std::vector<std::pair<std::string, LatencyHistogram::Snapshot>> snapshot(const bool &reset = false);
+
+    // Logs p50, p99, p99.9 and the maximum of every histogram with values
+    void log(const bool &reset = true);
+};
+
+#endif  // BYTRA_LATENCYSTATS_H
@@ -0,0 +1,50 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "LimitOrderChaser.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std::chrono;
+
+std::optional<double> LimitOrderChaser::chase(const Order &ord, const double &target,
+                                              const steady_clock::time_point &now) {
+    // Half a tick of slack so rounding in the prices can't hide a full tick
+    double distance = std::abs(target - ord.price);
+
+    if (distance < (settings.hysteresisTicks - 0.5) * settings.tickSize || distance == 0) {
+        pendingPrice.reset();
+        return std::nullopt;
+    }
+
+    if (now < nextAmendTime()) {
+        pendingPrice = target;
+        return std::nullopt;
+    }
+
+    pendingPrice.reset();
+    lastAmend = now;
+
+    if (rateLimitRemaining > 0) {
+        rateLimitRemaining--;
+    }
+
+    return target;
+}
+
+steady_clock::time_point LimitOrderChaser::nextAmendTime() const {
+    steady_clock::time_point next = lastAmend + settings.minAmendInterval;
+
+    if (rateLimitRemaining >= 0 && rateLimitRemaining <= settings.rateLimitReserve) {
+        next = std::max(next, rateLimitReset);
+    }
+
+    return next;
+}
+
+void LimitOrderChaser::onRateLimit(const long &remaining, const steady_clock::time_point &reset) {
+    rateLimitRemaining = remaining;
+    rateLimitReset = reset;
+}
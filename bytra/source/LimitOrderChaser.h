@@ -0,0 +1,59 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_LIMITORDERCHASER_H
+#define BYTRA_LIMITORDERCHASER_H
+
+#include <chrono>
+#include <optional>
+
+#include "Order.h"
+
+/** Decides when a working limit order is amended to follow the top of the book
+ * An amend is only sent when the target is at least hysteresisTicks away from the order price, at most once every
+ * minAmendInterval and not while the rate limit budget is down to its reserve. A target that is held back is kept,
+ * newer targets replace it, so the amend sent afterwards always goes to the latest price.
+ * */
+class LimitOrderChaser {
+  public:
+    struct Settings {
+        std::chrono::milliseconds minAmendInterval{0};
+        double tickSize = 0.5;
+        int hysteresisTicks = 1;
+        long rateLimitReserve = 0;  // requests kept aside for cancels and new orders
+    };
+
+  private:
+    Settings settings;
+    std::chrono::steady_clock::time_point lastAmend;
+    std::optional<double> pendingPrice;
+    long rateLimitRemaining = -1;  // unknown until the first response
+    std::chrono::steady_clock::time_point rateLimitReset;
+
+  public:
+    LimitOrderChaser() = default;
+
+    explicit LimitOrderChaser(const Settings &settings) : settings(settings) {}
+
+    // The top of the book left the price interval of the order, it is cancelled instead of chased
+    [[nodiscard]] static bool leftInterval(const Order &ord, const double &target) {
+        return target < ord.priceInterval.first || target > ord.priceInterval.second;
+    }
+
+    // Price to amend the order to right now, nothing when the order stays or the amend is held back
+    std::optional<double> chase(const Order &ord, const double &target,
+                                const std::chrono::steady_clock::time_point &now);
+
+    [[nodiscard]] bool hasPendingAmend() const { return pendingPrice.has_value(); }
+
+    // Earliest time a held back amend can be sent
+    [[nodiscard]] std::chrono::steady_clock::time_point nextAmendTime() const;
+
+    void onRateLimit(const long &remaining, const std::chrono::steady_clock::time_point &reset);
+
+    // The chased order is gone, a new order starts without a held back amend
+    void reset() { pendingPrice.reset(); }
+};
+
+#endif  // BYTRA_LIMITORDERCHASER_H
@@ -0,0 +1,161 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "MarketDataParser.h"
+
+using namespace simdjson;
+
+MarketDataParser::MarketDataParser(std::shared_ptr<OrderBook> orderBook, CandleHandler onCandle,
+                                   ResyncHandler onResync) {
+    this->orderBook = std::move(orderBook);
+    this->onCandle = std::move(onCandle);
+    this->onResync = std::move(onResync);
+}
+
+void MarketDataParser::addTopic(const std::string &topic) {
+    if (topic.rfind("orderBookL2_25.", 0) == 0) {
+        topics.add(topic,
+                   [this](ondemand::value &data, const std::string_view &type) { return parseOrderBook(data, type); });
+
+    } else if (topic.rfind("klineV2.", 0) == 0) {
+        // topic looks like klineV2.<interval>.<symbol>, the interval is only extracted once
+        std::string interval = topic.substr(8, topic.find('.', 8) - 8);
+        topics.add(topic, [this, interval](ondemand::value &data, const std::string_view &) {
+            parseKlines(data.get_array(), interval);
+            return true;
+        });
+    }
+}
+
+void MarketDataParser::clearTopics() { topics.clear(); }
+
+bool MarketDataParser::parse(const uint8_t *buf, const size_t &len) {
+    ondemand::document doc = parser.iterate(buf, len, len + SIMDJSON_PADDING);
+    const TopicHandler *handler = nullptr;
+    std::string_view type;
+
+    for (auto field : doc.get_object()) {
+        std::string_view key = field.unescaped_key();
+
+        if (!handler) {
+            // Bybit always sends the topic first, other messages are left to the DOM parser
+            if (key != "topic") {
+                return false;
+            }
+
+            handler = topics.find(field.value().get_string());
+
+            if (!handler) {
+                return false;
+            }
+
+        } else if (key == "type") {
+            type = field.value().get_string();
+
+        } else if (key == "data") {
+            ondemand::value data = field.value();
+            return (*handler)(data, type);
+        }
+    }
+
+    return handler != nullptr;
+}
+
+bool MarketDataParser::parseOrderBook(ondemand::value &data, const std::string_view &type) {
+    // Without the type it is unknown how to apply the data, nothing has been applied yet
+    if (type != "snapshot" && type != "delta") {
+        return false;
+    }
+
+    try {
+        if (type == "snapshot") {
+            orderBook->clear();
+            parseOrderBookEntries(data.get_array(), 'i');
+
+        } else {
+            for (auto action : data.get_object()) {
+                std::string_view actionKey = action.unescaped_key();
+
+                if (actionKey == "delete" || actionKey == "update" || actionKey == "insert") {
+                    parseOrderBookEntries(action.value().get_array(), actionKey[0]);
+                }
+            }
+        }
+    } catch (const simdjson_error &e) {
+        // Part of the message may already be applied, parsing it again would not repair the book
+        onResync(e.what());
+    }
+
+    return true;
+}
+
+void MarketDataParser::parseOrderBookEntries(ondemand::array entries, const char &action) {
+    for (auto entry : entries) {
+        long id = 0;
+        long size = 0;
+        double price = 0;
+        bool isSell = false;
+
+        for (auto field : entry.get_object()) {
+            std::string_view key = field.unescaped_key();
+
+            if (key == "id") {
+                id = field.value().get_int64();
+            } else if (key == "price") {
+                price = field.value().get_double_in_string();  // price is sent as a string
+            } else if (key == "side") {
+                std::string_view side = field.value().get_string();
+                isSell = side == "Sell";
+            } else if (key == "size") {
+                size = field.value().get_int64();
+            }
+        }
+
+        switch (action) {
+            case 'd':
+                isSell ? orderBook->removeAskEntry(id) : orderBook->removeBidEntry(id);
+                break;
+            case 'u':
+                isSell ? orderBook->updateAskEntry(id, size) : orderBook->updateBidEntry(id, size);
+                break;
+            case 'i':
+                isSell ? orderBook->addAskEntry(id, OrderBookEntry(price, size))
+                       : orderBook->addBidEntry(id, OrderBookEntry(price, size));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void MarketDataParser::parseKlines(ondemand::array klines, const std::string &interval) {
+    for (auto kline : klines) {
+        Candle candle{};
+        bool confirm = false;
+
+        for (auto field : kline.get_object()) {
+            std::string_view key = field.unescaped_key();
+
+            if (key == "start") {
+                candle.timestamp = field.value().get_int64();
+            } else if (key == "open") {
+                candle.open = field.value().get_double();
+            } else if (key == "high") {
+                candle.high = field.value().get_double();
+            } else if (key == "low") {
+                candle.low = field.value().get_double();
+            } else if (key == "close") {
+                candle.close = field.value().get_double();
+            } else if (key == "volume") {
+                candle.volume = field.value().get_double();
+            } else if (key == "confirm") {
+                confirm = field.value().get_bool();
+            }
+        }
+
+        if (confirm) {
+            onCandle(interval, candle);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_MARKETDATAPARSER_H
+#define BYTRA_MARKETDATAPARSER_H
+
+#include <simdjson.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "Candle.h"
+#include "OrderBook.h"
+#include "TopicTable.h"
+
+/** On-Demand parser for the hot websocket topics
+ * Order book (orderBookL2_25) and kline (klineV2) messages make up almost all of the websocket traffic.
+ * Instead of building a DOM tree and looking fields up by key, their fields are streamed once,
+ * in document order, straight into the order book or the candle handler.
+ * Other messages are left to the DOM parser, as are order book messages that send their data before their type.
+ * A message that fails halfway through leaves the order book partly applied, onResync is called to replace it.
+ * */
+class MarketDataParser {
+  public:
+    using CandleHandler = std::function<void(const std::string_view &interval, const Candle &candle)>;
+    using ResyncHandler = std::function<void(const std::string_view &error)>;
+
+  private:
+    // Returns false if the message can not be handled, it is then left to the DOM parser
+    using TopicHandler = std::function<bool(simdjson::ondemand::value &data, const std::string_view &type)>;
+
+    simdjson::ondemand::parser parser;
+    std::shared_ptr<OrderBook> orderBook;
+    CandleHandler onCandle;
+    ResyncHandler onResync;
+    TopicTable<TopicHandler> topics;
+
+    bool parseOrderBook(simdjson::ondemand::value &data, const std::string_view &type);
+
+    void parseOrderBookEntries(simdjson::ondemand::array entries, const char &action);
+
+    void parseKlines(simdjson::ondemand::array klines, const std::string &interval);
+
+  public:
+    MarketDataParser(std::shared_ptr<OrderBook> orderBook, CandleHandler onCandle, ResyncHandler onResync);
+
+    // Topics that are not order book or kline topics are ignored
+    void addTopic(const std::string &topic);
+
+    void clearTopics();
+
+    // buf must be followed by SIMDJSON_PADDING readable bytes.
+    // Returns false if the message is not for one of the added topics or has to go through the DOM parser,
+    // nothing is applied in that case.
+    bool parse(const uint8_t *buf, const size_t &len);
+};
+
+#endif  // BYTRA_MARKETDATAPARSER_H
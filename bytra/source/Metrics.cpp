@@ -0,0 +1,87 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "Metrics.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <iterator>
+#include <stdexcept>
+
+Metrics::Family &Metrics::family(const std::string &name, const std::string &help, const Type &type) {
+    for (auto &f : families) {
+        if (f.name == name) {
+            if (f.type != type) {
+                throw std::invalid_argument("Metric " + name + " is registered with another type.");
+            }
+            return f;
+        }
+    }
+
+    return families.emplace_back(Family{name, help, type, {}});
+}
+
+Metrics::Counter &Metrics::counter(const std::string &name, const std::string &help, const std::string &labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Family &f = family(name, help, Type::Counter);
+
+    for (auto &s : f.series) {
+        if (s.labels == labels) {
+            return *s.counter;
+        }
+    }
+
+    Counter &c = counters.emplace_back();
+    f.series.push_back({labels, &c, nullptr, {}});
+    return c;
+}
+
+Metrics::Gauge &Metrics::gauge(const std::string &name, const std::string &help, const std::string &labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Gauge &g = gauges.emplace_back();
+    family(name, help, Type::Gauge).series.push_back({labels, nullptr, &g, {}});
+    return g;
+}
+
+void Metrics::gauge(const std::string &name, const std::string &help, std::function<double()> read,
+                    const std::string &labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    family(name, help, Type::Gauge).series.push_back({labels, nullptr, nullptr, std::move(read)});
+}
+
+void Metrics::addCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(mutex);
+    collectors.push_back(std::move(collector));
+}
+
+std::string Metrics::render() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string out;
+    out.reserve(4096);
+
+    for (const auto &f : families) {
+        fmt::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", f.name, f.help, f.name,
+                       f.type == Type::Counter ? "counter" : "gauge");
+
+        for (const auto &s : f.series) {
+            out += f.name;
+
+            if (!s.labels.empty()) {
+                out += '{' + s.labels + '}';
+            }
+
+            if (s.counter) {
+                fmt::format_to(std::back_inserter(out), " {}\n", s.counter->get());
+            } else {
+                fmt::format_to(std::back_inserter(out), " {}\n", s.gauge ? s.gauge->get() : s.read());
+            }
+        }
+    }
+
+    for (const auto &collector : collectors) {
+        collector(out);
+    }
+
+    return out;
+}
@@ -0,0 +1,86 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_METRICS_H
+#define BYTRA_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** Counters and gauges of the engine, rendered in the Prometheus text format
+ * Metrics are registered once at startup, the returned references stay valid for the lifetime of the registry.
+ * Updating one is a relaxed atomic operation, rendering reads the atomics without ever blocking an update.
+ * */
+class Metrics {
+  public:
+    class Counter {
+      private:
+        std::atomic<uint64_t> value{0};
+
+      public:
+        void increment(const uint64_t &n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+
+        [[nodiscard]] uint64_t get() const { return value.load(std::memory_order_relaxed); }
+    };
+
+    class Gauge {
+      private:
+        std::atomic<double> value{0};
+
+      public:
+        void set(const double &v) { value.store(v, std::memory_order_relaxed); }
+
+        [[nodiscard]] double get() const { return value.load(std::memory_order_relaxed); }
+    };
+
+    // Appends complete metric families to the output, has to be safe to call from the metrics server thread
+    using Collector = std::function<void(std::string &)>;
+
+  private:
+    enum class Type { Counter, Gauge };
+
+    struct Series {
+        std::string labels;
+        Counter *counter = nullptr;
+        const Gauge *gauge = nullptr;
+        std::function<double()> read;
+    };
+
+    struct Family {
+        std::string name;
+        std::string help;
+        Type type;
+        std::vector<Series> series;
+    };
+
+    std::mutex mutex;  // guards registration against rendering, never taken when a metric is updated
+    std::deque<Family> families;
+    std::deque<Counter> counters;
+    std::deque<Gauge> gauges;
+    std::vector<Collector> collectors;
+
+    Family &family(const std::string &name, const std::string &help, const Type &type);
+
+  public:
+    // labels are written as is, like endpoint="/v2/private/order/create". Registering the same name and labels
+    // again returns the existing counter, so series only known at runtime can be added when they first occur.
+    Counter &counter(const std::string &name, const std::string &help, const std::string &labels = "");
+
+    Gauge &gauge(const std::string &name, const std::string &help, const std::string &labels = "");
+
+    // Gauge that is read when rendered, read has to be safe to call from the metrics server thread
+    void gauge(const std::string &name, const std::string &help, std::function<double()> read,
+               const std::string &labels = "");
+
+    void addCollector(Collector collector);
+
+    std::string render();
+};
+
+#endif  // BYTRA_METRICS_H
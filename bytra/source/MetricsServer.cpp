@@ -0,0 +1,74 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "MetricsServer.h"
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <chrono>
+
+#include "AsyncLogger.h"
+
+namespace beast = boost::beast;  // from <boost/beast.hpp>
+namespace http = beast::http;    // from <boost/beast/http.hpp>
+using tcp = boost::asio::ip::tcp;  // from <boost/asio/ip/tcp.hpp>
+
+MetricsServer::MetricsServer(std::shared_ptr<Metrics> metrics, const unsigned short &port)
+    : metrics(std::move(metrics)), acceptor(ioc, tcp::endpoint(net::ip::address_v4::loopback(), port)) {
+    BYTRA_LOG_INFO("[Metrics] Listening on 127.0.0.1:{}", port);
+    accept();
+    thread = std::thread([this] { ioc.run(); });
+}
+
+MetricsServer::~MetricsServer() {
+    ioc.stop();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void MetricsServer::accept() {
+    acceptor.async_accept([this](const beast::error_code &ec, tcp::socket socket) {
+        if (ec) {
+            BYTRA_LOG_WARN("[Metrics] accept failed: {}", ec.message());
+        } else {
+            serve(std::move(socket));
+        }
+
+        accept();
+    });
+}
+
+void MetricsServer::serve(tcp::socket socket) {
+    auto stream = std::make_shared<beast::tcp_stream>(std::move(socket));
+    auto buffer = std::make_shared<beast::flat_buffer>();
+    auto request = std::make_shared<http::request<http::string_body>>();
+
+    // A client that stalls is dropped instead of holding on to the connection
+    stream->expires_after(std::chrono::seconds(5));
+    http::async_read(*stream, *buffer, *request, [this, stream, buffer, request](const beast::error_code &ec, size_t) {
+        if (ec) {
+            return;
+        }
+
+        auto response = std::make_shared<http::response<http::string_body>>();
+        response->version(request->version());
+        response->keep_alive(false);
+
+        if (request->method() == http::verb::get && request->target() == "/metrics") {
+            response->result(http::status::ok);
+            response->set(http::field::content_type, "text/plain; version=0.0.4");
+            response->body() = metrics->render();
+        } else {
+            response->result(http::status::not_found);
+        }
+
+        response->prepare_payload();
+        http::async_write(*stream, *response, [stream, response](const beast::error_code &, size_t) {
+            beast::error_code ec;
+            stream->socket().shutdown(tcp::socket::shutdown_send, ec);
+        });
+    });
+}
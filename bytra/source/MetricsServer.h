@@ -0,0 +1,41 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_METRICSSERVER_H
+#define BYTRA_METRICSSERVER_H
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <memory>
+#include <thread>
+
+#include "Metrics.h"
+
+namespace net = boost::asio;  // from <boost/asio.hpp>
+
+/** HTTP listener on localhost that serves the metrics at /metrics for Prometheus to scrape
+ * It runs its own io_context on its own thread, a scrape never touches the trading thread.
+ * */
+class MetricsServer {
+  private:
+    std::shared_ptr<Metrics> metrics;
+    net::io_context ioc;
+    net::ip::tcp::acceptor acceptor;
+    std::thread thread;
+
+    void accept();
+
+    void serve(net::ip::tcp::socket socket);
+
+  public:
+    MetricsServer(std::shared_ptr<Metrics> metrics, const unsigned short &port);
+
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer &) = delete;
+
+    MetricsServer &operator=(const MetricsServer &) = delete;
+};
+
+#endif  // BYTRA_METRICSSERVER_H
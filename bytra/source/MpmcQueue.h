@@ -0,0 +1,89 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_MPMCQUEUE_H
+#define BYTRA_MPMCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/** Bounded lock-free multi-producer/multi-consumer queue (Dmitry Vyukov's design)
+ * Every slot carries a sequence number that tells producers and consumers whose turn it is, so threads only
+ * contend on the head or tail counter. The capacity has to be a power of two.
+ * */
+template <typename T, std::size_t Capacity> class MpmcQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  private:
+    static constexpr std::size_t cacheLineSize = 64;
+    static constexpr std::size_t mask = Capacity - 1;
+
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T item;
+    };
+
+    alignas(cacheLineSize) std::atomic<std::size_t> head{0};  // next position to pop
+    alignas(cacheLineSize) std::atomic<std::size_t> tail{0};  // next position to push
+    alignas(cacheLineSize) std::array<Slot, Capacity> slots;
+
+  public:
+    MpmcQueue() {
+        for (std::size_t i = 0; i < Capacity; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue &) = delete;
+
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    bool push(const T &item) {
+        std::size_t position = tail.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Slot &slot = slots[position & mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.item = item;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;  // full
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(T &item) {
+        std::size_t position = head.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Slot &slot = slots[position & mask];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+            if (difference == 0) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    item = std::move(slot.item);
+                    slot.sequence.store(position + Capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;  // empty
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+#endif  // BYTRA_MPMCQUEUE_H
@@ -6,18 +6,28 @@
 #define MEXTRA_ORDER_H
 
 #include <chrono>
+#include <memory>
 #include <string>
 
 using namespace std::chrono;
 
+using OrderHandle = unsigned long;  // local reference to an order, assigned by the OrderGateway
+
+class PreparedRequest;
+
 class Order {
   public:
     std::string id;
-    long qty;
-    double price;
+    std::string linkId;  // order_link_id, assigned by the OrderManager
+    OrderHandle handle = 0;
+    long qty = 0;
+    double price = 0;
     std::pair<double, double> priceInterval;
-    double slippage;
+    double slippage = 0;
     bool reduce = true;
+    std::shared_ptr<const PreparedRequest> prepared;  // request built ahead of time, see Bybit::prepareOrders
+
+    Order() = default;
 
     Order(const long &qty, const bool &reduce = false) {
         this->reduce = reduce;
@@ -32,6 +42,11 @@ class Order {
         this->priceInterval = {price - slippage, price + slippage};
     }
 
+    void setLimitPrice(const double &price) {
+        this->price = price;
+        this->priceInterval = {price - slippage, price + slippage};
+    }
+
     [[nodiscard]] bool isSell() const { return qty < 0; }
 
     [[nodiscard]] bool isBuy() const { return qty > 0; }
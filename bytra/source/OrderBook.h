@@ -5,6 +5,7 @@
 #ifndef BYTRA_ORDERBOOK_H
 #define BYTRA_ORDERBOOK_H
 
+#include <limits>
 #include <map>
 
 struct OrderBookEntry {
@@ -24,43 +25,86 @@ class OrderBook {
     std::map<long, OrderBookEntry> askSide;
     std::map<long, OrderBookEntry> bidSide;
 
+    // Best prices are recalculated lazily, only after the book changed
+    bool pricesChanged = true;
+    double bestAskPrice = std::numeric_limits<double>::infinity();
+    double bestBidPrice = 0.0;
+
+    void updateBestPrices() {
+        bestAskPrice = std::numeric_limits<double>::infinity();
+        bestBidPrice = 0.0;
+
+        for (auto const &[key, val] : askSide) {
+            if (val.price < bestAskPrice) {
+                bestAskPrice = val.price;
+            }
+        }
+
+        for (auto const &[key, val] : bidSide) {
+            if (val.price > bestBidPrice) {
+                bestBidPrice = val.price;
+            }
+        }
+
+        pricesChanged = false;
+    }
+
   public:
     OrderBook() = default;
 
-    void addAskEntry(const long &id, const OrderBookEntry &entry) { askSide[id] = entry; }
+    void addAskEntry(const long &id, const OrderBookEntry &entry) {
+        askSide[id] = entry;
+        pricesChanged = true;
+    }
+
+    void addBidEntry(const long &id, const OrderBookEntry &entry) {
+        bidSide[id] = entry;
+        pricesChanged = true;
+    }
 
-    void addBidEntry(const long &id, const OrderBookEntry &entry) { bidSide[id] = entry; }
+    void removeAskEntry(const long &id) {
+        askSide.erase(id);
+        pricesChanged = true;
+    }
 
-    void removeAskEntry(const long &id) { askSide.erase(id); }
+    void removeBidEntry(const long &id) {
+        bidSide.erase(id);
+        pricesChanged = true;
+    }
 
-    void removeBidEntry(const long &id) { bidSide.erase(id); }
+    // Updates only change the size, an update for an unknown id is ignored
+    void updateAskEntry(const long &id, const long &newSize) {
+        if (auto it = askSide.find(id); it != askSide.end()) {
+            it->second.size = newSize;
+        }
+    }
 
-    void updateAskEntry(const long &id, const long &newSize) { askSide[id].size = newSize; }
+    void updateBidEntry(const long &id, const long &newSize) {
+        if (auto it = bidSide.find(id); it != bidSide.end()) {
+            it->second.size = newSize;
+        }
+    }
 
-    void updateBidEntry(const long &id, const long &newSize) { bidSide[id].size = newSize; }
+    void clear() {
+        askSide.clear();
+        bidSide.clear();
+        pricesChanged = true;
+    }
 
     double askPrice() {
-        double askPrice = std::numeric_limits<double>::infinity();
-
-        for (auto const &[key, val] : askSide) {
-            if (val.price < askPrice) {
-                askPrice = val.price;
-            }
+        if (pricesChanged) {
+            updateBestPrices();
         }
 
-        return askPrice;
+        return bestAskPrice;
     }
 
     double bidPrice() {
-        double bidPrice = 0.0;
-
-        for (auto const &[key, val] : bidSide) {
-            if (val.price > bidPrice) {
-                bidPrice = val.price;
-            }
+        if (pricesChanged) {
+            updateBestPrices();
         }
 
-        return bidPrice;
+        return bestBidPrice;
     }
 
     bool isEmpty() { return askSide.empty() || bidSide.empty(); }
@@ -0,0 +1,90 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "OrderExecutor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "AsyncLogger.h"
+
+OrderExecutor::OrderExecutor(Handler handler, Notifier notifier, Admission admission) {
+    this->handler = std::move(handler);
+    this->notifier = std::move(notifier);
+    this->admission = std::move(admission);
+    thread = std::thread(&OrderExecutor::run, this);
+}
+
+OrderExecutor::~OrderExecutor() {
+    running = false;
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void OrderExecutor::submit(const OrderRequest &request) {
+    if (!requests.push(request)) {
+        BYTRA_LOG_ERROR("OrderExecutor::submit - request queue is full");
+        throw std::runtime_error("Order request queue is full.");
+    }
+}
+
+bool OrderExecutor::poll(OrderReport &report) { return reports.pop(report); }
+
+bool OrderExecutor::nextRequest(OrderRequest &request) {
+    while (requests.pop(request)) {
+        waiting.push_back(std::move(request));
+    }
+
+    // Highest priority first, in submission order within a priority
+    std::stable_sort(waiting.begin(), waiting.end(), [](const OrderRequest &a, const OrderRequest &b) {
+        return a.priority < b.priority;
+    });
+
+    for (auto it = waiting.begin(); it != waiting.end(); it++) {
+        if (!admission || admission(*it)) {
+            request = std::move(*it);
+            waiting.erase(it);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void OrderExecutor::run() {
+    int idleRounds = 0;
+    OrderRequest request;
+
+    while (running) {
+        if (!nextRequest(request)) {
+            // Spin for a short while so a new order is picked up immediately, back off when idle
+            if (++idleRounds < 1000) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            continue;
+        }
+
+        idleRounds = 0;
+        OrderReport report;
+
+        try {
+            report = handler(request);
+        } catch (const std::exception &e) {
+            report.type = request.type;
+            report.order = request.order;
+            report.error = e.what();
+        }
+
+        while (!reports.push(report)) {
+            std::this_thread::yield();
+        }
+
+        notifier();
+    }
+}
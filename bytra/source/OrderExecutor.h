@@ -0,0 +1,104 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_ORDEREXECUTOR_H
+#define BYTRA_ORDEREXECUTOR_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Order.h"
+#include "RateLimiter.h"
+#include "SpscQueue.h"
+
+enum class OrderRequestType { Market, Limit, Amend, Cancel, TradingStop };
+
+struct OrderRequest {
+    OrderRequestType type = OrderRequestType::Market;
+    Order order;
+    RequestPriority priority = RequestPriority::Critical;
+    std::chrono::steady_clock::time_point submitTime;
+};
+
+// Cancels and anything that reduces risk go first, amends only follow the book and can wait
+inline RequestPriority requestPriority(const OrderRequestType &type) {
+    switch (type) {
+        case OrderRequestType::Market:
+        case OrderRequestType::Cancel:
+        case OrderRequestType::TradingStop:
+            return RequestPriority::Critical;
+        case OrderRequestType::Limit:
+            return RequestPriority::Order;
+        case OrderRequestType::Amend:
+            return RequestPriority::Amend;
+    }
+
+    return RequestPriority::Critical;
+}
+
+struct OrderReport {
+    OrderRequestType type = OrderRequestType::Market;
+    Order order;
+    int retCode = 0;
+    std::string orderId;
+    std::string error;  // set when the request failed on the executor thread
+    long rateLimitStatus = -1;  // requests left in the current rate limit window, -1 when unknown
+    long rateLimitResetMs = 0;  // when the window resets, in milliseconds since epoch
+
+    OrderReport() = default;
+
+    OrderReport(const OrderRequestType &type, const Order &order, const int &retCode, std::string orderId = "") {
+        this->type = type;
+        this->order = order;
+        this->retCode = retCode;
+        this->orderId = std::move(orderId);
+    }
+
+    [[nodiscard]] bool failed() const { return !error.empty(); }
+};
+
+/** Sends orders on a dedicated thread
+ * The market data thread pushes requests and pops reports, the executor thread does the (blocking) REST calls.
+ * Both directions use a single-producer/single-consumer queue so neither side takes a lock.
+ * A request is only sent once the admission check lets it through, waiting requests are sent by priority.
+ * */
+class OrderExecutor {
+  public:
+    using Handler = std::function<OrderReport(const OrderRequest &)>;
+    using Notifier = std::function<void()>;
+    using Admission = std::function<bool(const OrderRequest &)>;
+
+  private:
+    SpscQueue<OrderRequest, 64> requests;
+    SpscQueue<OrderReport, 64> reports;
+    Handler handler;
+    Notifier notifier;
+    Admission admission;
+    std::vector<OrderRequest> waiting;  // only used by the executor thread
+    std::atomic<bool> running{true};
+    std::thread thread;
+
+    bool nextRequest(OrderRequest &request);
+
+    void run();
+
+  public:
+    OrderExecutor(Handler handler, Notifier notifier, Admission admission = {});
+
+    ~OrderExecutor();
+
+    OrderExecutor(const OrderExecutor &) = delete;
+
+    OrderExecutor &operator=(const OrderExecutor &) = delete;
+
+    void submit(const OrderRequest &request);
+
+    bool poll(OrderReport &report);
+};
+
+#endif  // BYTRA_ORDEREXECUTOR_H
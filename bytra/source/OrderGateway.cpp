@@ -0,0 +1,158 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "OrderGateway.h"
+
+OrderGateway::OrderGateway(OrderExecutor::Handler handler, OrderExecutor::Notifier notifier,
+                           OrderExecutor::Admission admission)
+    : executor(std::move(handler), std::move(notifier), std::move(admission)) {}
+
+OrderHandle OrderGateway::track(const Order &ord, Completion completion) {
+    OrderHandle handle = nextHandle++;
+    TrackedOrder &tracked = orders[handle];
+    tracked.order = ord;
+    tracked.order.handle = handle;
+    tracked.completion = std::move(completion);
+    return handle;
+}
+
+void OrderGateway::send(OrderRequestType type, TrackedOrder &tracked) {
+    tracked.inFlight = true;
+    executor.submit(OrderRequest{type, tracked.order, requestPriority(type), std::chrono::steady_clock::now()});
+}
+
+OrderHandle OrderGateway::submitMarket(const Order &ord, Completion completion) {
+    OrderHandle handle = track(ord, std::move(completion));
+    send(OrderRequestType::Market, orders[handle]);
+    return handle;
+}
+
+OrderHandle OrderGateway::submitLimit(const Order &ord, Completion completion) {
+    OrderHandle handle = track(ord, std::move(completion));
+    send(OrderRequestType::Limit, orders[handle]);
+    return handle;
+}
+
+OrderHandle OrderGateway::submitTradingStop(const Order &ord, Completion completion) {
+    OrderHandle handle = track(ord, std::move(completion));
+    send(OrderRequestType::TradingStop, orders[handle]);
+    return handle;
+}
+
+void OrderGateway::amend(const OrderHandle &handle, const double &price) {
+    auto it = orders.find(handle);
+
+    if (it == orders.end() || it->second.pendingCancel) {
+        return;
+    }
+
+    TrackedOrder &tracked = it->second;
+
+    if (tracked.inFlight || !tracked.acknowledged) {
+        tracked.pendingAmendPrice = price;
+        return;
+    }
+
+    tracked.order.price = price;
+    send(OrderRequestType::Amend, tracked);
+}
+
+void OrderGateway::cancel(const OrderHandle &handle) {
+    auto it = orders.find(handle);
+
+    if (it == orders.end()) {
+        return;
+    }
+
+    TrackedOrder &tracked = it->second;
+    tracked.pendingAmendPrice.reset();
+
+    if (tracked.inFlight || !tracked.acknowledged) {
+        tracked.pendingCancel = true;
+        return;
+    }
+
+    send(OrderRequestType::Cancel, tracked);
+}
+
+void OrderGateway::forget(const OrderHandle &handle) { orders.erase(handle); }
+
+bool OrderGateway::isInFlight(const OrderHandle &handle) const {
+    auto it = orders.find(handle);
+    return it != orders.end() && it->second.inFlight;
+}
+
+size_t OrderGateway::requestsInFlight() const {
+    size_t inFlight = 0;
+
+    for (auto const &[handle, tracked] : orders) {
+        if (tracked.inFlight) {
+            inFlight++;
+        }
+    }
+
+    return inFlight;
+}
+
+void OrderGateway::processReports() {
+    OrderReport report;
+
+    while (executor.poll(report)) {
+        auto it = orders.find(report.order.handle);
+
+        if (it == orders.end()) {
+            continue;  // forgotten while in flight
+        }
+
+        TrackedOrder &tracked = it->second;
+        Completion completion = tracked.completion;
+        tracked.inFlight = false;
+
+        bool retry = report.failed()
+                     && (report.type == OrderRequestType::Amend || report.type == OrderRequestType::Cancel);
+        bool done = (report.failed() && !retry) || report.type == OrderRequestType::Market
+                    || (report.type == OrderRequestType::Cancel && !retry)
+                    || report.type == OrderRequestType::TradingStop;
+
+        if (report.type == OrderRequestType::Limit && !report.failed()) {
+            tracked.order.id = report.orderId;
+            tracked.acknowledged = true;
+        } else if (report.type == OrderRequestType::Amend
+                   && (report.retCode == 30032 || report.retCode == 30037 || report.retCode == 20001)) {
+            // order is already filled, cancelled or unknown to the exchange
+            done = true;
+        }
+
+        if (!retry) {
+            tracked.failures = 0;
+        } else if (++tracked.failures < maxAttempts) {
+            if (report.type == OrderRequestType::Cancel) {
+                tracked.pendingCancel = true;
+            } else if (!tracked.pendingCancel && !tracked.pendingAmendPrice) {
+                tracked.pendingAmendPrice = tracked.order.price;
+            }
+        } else if (report.type == OrderRequestType::Amend) {
+            // A stale price is worse than no order
+            tracked.failures = 0;
+            tracked.pendingAmendPrice.reset();
+            tracked.pendingCancel = true;
+        }
+
+        if (done) {
+            orders.erase(it);
+        } else if (tracked.pendingCancel) {
+            tracked.pendingCancel = false;
+            send(OrderRequestType::Cancel, tracked);
+        } else if (tracked.pendingAmendPrice) {
+            tracked.order.price = *tracked.pendingAmendPrice;
+            tracked.pendingAmendPrice.reset();
+            send(OrderRequestType::Amend, tracked);
+        }
+
+        // The callback may use the gateway again, so it is called after the bookkeeping
+        if (completion) {
+            completion(report);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_ORDERGATEWAY_H
+#define BYTRA_ORDERGATEWAY_H
+
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
+#include "Order.h"
+#include "OrderExecutor.h"
+
+/** Non-blocking order API
+ * Submit, amend and cancel return immediately, the REST calls are done by the OrderExecutor.
+ * Completions are delivered to the callback of the order from processReports, which runs on the trading thread.
+ * While a request of an order is in flight, newer amends are coalesced to the latest price and a cancel
+ * overrides any pending amend. They are sent as soon as the in flight request completes.
+ * A failed amend or cancel leaves the order live on the exchange, so the order stays tracked and the request is
+ * retried. An order that can't be amended after maxAttempts is cancelled instead.
+ * */
+class OrderGateway {
+  public:
+    using Completion = std::function<void(const OrderReport &)>;
+
+  private:
+    struct TrackedOrder {
+        Order order;
+        Completion completion;
+        bool inFlight = false;
+        bool acknowledged = false;  // the exchange order id is known
+        bool pendingCancel = false;
+        std::optional<double> pendingAmendPrice;
+        int failures = 0;  // failed amends or cancels in a row
+    };
+
+    static constexpr int maxAttempts = 3;
+
+    OrderExecutor executor;
+    std::unordered_map<OrderHandle, TrackedOrder> orders;
+    OrderHandle nextHandle = 1;
+
+    OrderHandle track(const Order &ord, Completion completion);
+
+    void send(OrderRequestType type, TrackedOrder &tracked);
+
+  public:
+    OrderGateway(OrderExecutor::Handler handler, OrderExecutor::Notifier notifier,
+                 OrderExecutor::Admission admission = {});
+
+    OrderHandle submitMarket(const Order &ord, Completion completion = {});
+
+    OrderHandle submitLimit(const Order &ord, Completion completion = {});
+
+    // Sets the stop loss of the position on the exchange to ord.price
+    OrderHandle submitTradingStop(const Order &ord, Completion completion = {});
+
+    void amend(const OrderHandle &handle, const double &price);
+
+    void cancel(const OrderHandle &handle);
+
+    void forget(const OrderHandle &handle);
+
+    [[nodiscard]] bool isInFlight(const OrderHandle &handle) const;
+
+    // Number of tracked orders with a request waiting for its response
+    [[nodiscard]] size_t requestsInFlight() const;
+
+    void processReports();
+};
+
+#endif  // BYTRA_ORDERGATEWAY_H
@@ -0,0 +1,157 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "OrderManager.h"
+
+#include <algorithm>
+#include <charconv>
+
+#include "AsyncLogger.h"
+
+OrderManager::OrderManager(std::string linkIdPrefix) : linkIdPrefix(std::move(linkIdPrefix)) {
+    orders.reserve(64);
+}
+
+bool OrderManager::parseSequence(const std::string_view &linkId, unsigned long &sequence) const {
+    // Orders placed by hand or by an earlier session have another prefix, or no order_link_id at all
+    if (linkId.size() <= linkIdPrefix.size() || linkId.compare(0, linkIdPrefix.size(), linkIdPrefix) != 0) {
+        return false;
+    }
+
+    auto result = std::from_chars(linkId.data() + linkIdPrefix.size(), linkId.data() + linkId.size(), sequence);
+    return result.ec == std::errc() && result.ptr == linkId.data() + linkId.size();
+}
+
+ManagedOrder *OrderManager::find(const std::string_view &linkId) {
+    unsigned long sequence;
+
+    if (!parseSequence(linkId, sequence)) {
+        return nullptr;
+    }
+
+    for (auto &tracked : orders) {
+        if (tracked.sequence == sequence) {
+            return &tracked.managed;
+        }
+    }
+
+    return nullptr;
+}
+
+bool OrderManager::canTransition(const OrderState &from, const OrderState &to) {
+    switch (from) {
+        case OrderState::PendingNew:
+            return to != OrderState::PendingNew;
+        case OrderState::New:
+        case OrderState::PartiallyFilled:
+            return to != OrderState::PendingNew && to != OrderState::New && to != OrderState::Rejected;
+        case OrderState::Filled:
+        case OrderState::Cancelled:
+        case OrderState::Rejected:
+            return false;
+    }
+
+    return false;
+}
+
+void OrderManager::transition(ManagedOrder &managed, const OrderState &state) {
+    if (managed.state == state) {
+        return;
+    }
+
+    // Reports can arrive out of order, a late one must not bring an order back to life
+    if (!canTransition(managed.state, state)) {
+        BYTRA_LOG_DEBUG("OrderManager - ignoring transition of {} from {} to {}", managed.order.linkId,
+                      static_cast<int>(managed.state), static_cast<int>(state));
+        return;
+    }
+
+    managed.state = state;
+}
+
+Order OrderManager::add(Order ord) {
+    unsigned long sequence = nextSequence++;
+    ord.linkId = linkIdPrefix + std::to_string(sequence);
+    orders.push_back({sequence, ManagedOrder{ord}});
+
+    return ord;
+}
+
+void OrderManager::acknowledge(const std::string_view &linkId, const std::string &orderId) {
+    if (auto *managed = find(linkId)) {
+        if (managed->order.id.empty()) {
+            managed->order.id = orderId;
+        }
+
+        if (managed->state == OrderState::PendingNew) {
+            transition(*managed, OrderState::New);
+        }
+    }
+}
+
+void OrderManager::reject(const std::string_view &linkId) {
+    if (auto *managed = find(linkId)) {
+        transition(*managed, OrderState::Rejected);
+    }
+}
+
+const ManagedOrder *OrderManager::onExecutionReport(const std::string_view &linkId,
+                                                    const std::string_view &orderStatus, const long &filledQty) {
+    ManagedOrder *managed = find(linkId);
+
+    if (managed == nullptr) {
+        return nullptr;
+    }
+
+    managed->filledQty = std::max(managed->filledQty, filledQty);
+
+    if (orderStatus == "Created") {
+        transition(*managed, OrderState::PendingNew);
+    } else if (orderStatus == "New") {
+        transition(*managed, OrderState::New);
+    } else if (orderStatus == "PartiallyFilled") {
+        transition(*managed, OrderState::PartiallyFilled);
+    } else if (orderStatus == "Filled") {
+        transition(*managed, OrderState::Filled);
+    } else if (orderStatus == "Cancelled") {
+        transition(*managed, OrderState::Cancelled);
+    } else if (orderStatus == "Rejected") {
+        transition(*managed, OrderState::Rejected);
+    }
+
+    return managed;
+}
+
+void OrderManager::remove(const std::string_view &linkId) {
+    unsigned long sequence;
+
+    if (!parseSequence(linkId, sequence)) {
+        return;
+    }
+
+    // The order of the orders doesn't matter, the last one takes the place of the removed one
+    for (auto &tracked : orders) {
+        if (tracked.sequence == sequence) {
+            if (&tracked != &orders.back()) {
+                tracked = std::move(orders.back());
+            }
+            orders.pop_back();
+            return;
+        }
+    }
+}
+
+void OrderManager::clear() { orders.clear(); }
+
+size_t OrderManager::workingOrders() const {
+    size_t working = 0;
+
+    for (auto const &tracked : orders) {
+        if (!tracked.managed.isFinished()) {
+            working++;
+        }
+    }
+
+    return working;
+}
@@ -0,0 +1,75 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_ORDERMANAGER_H
+#define BYTRA_ORDERMANAGER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Order.h"
+
+enum class OrderState { PendingNew, New, PartiallyFilled, Filled, Cancelled, Rejected };
+
+struct ManagedOrder {
+    Order order;
+    OrderState state = OrderState::PendingNew;
+    long filledQty = 0;
+
+    [[nodiscard]] bool isFinished() const {
+        return state == OrderState::Filled || state == OrderState::Cancelled || state == OrderState::Rejected;
+    }
+};
+
+/** Lifecycle of every order placed in this session, any number of them can be working at the same time
+ * Each order gets an order_link_id made of a per session prefix and a sequence number. Execution reports are
+ * matched on that id, the sequence number is the key the orders are looked up by so a lookup needs no string
+ * allocation. Finished orders stay tracked until they are removed, which Bybit does as soon as they finish,
+ * so only a handful of orders are tracked. They are kept in a vector, a scan of it is cheaper than a hash lookup.
+ * */
+class OrderManager {
+  private:
+    struct TrackedOrder {
+        unsigned long sequence;
+        ManagedOrder managed;
+    };
+
+    std::string linkIdPrefix;
+    unsigned long nextSequence = 1;
+    std::vector<TrackedOrder> orders;
+
+    bool parseSequence(const std::string_view &linkId, unsigned long &sequence) const;
+
+    ManagedOrder *find(const std::string_view &linkId);
+
+    void transition(ManagedOrder &managed, const OrderState &state);
+
+  public:
+    explicit OrderManager(std::string linkIdPrefix);
+
+    // Finished orders stay finished and a working order can't go back to PendingNew or New
+    static bool canTransition(const OrderState &from, const OrderState &to);
+
+    // Starts tracking an order as PendingNew, the returned copy has its order_link_id set
+    Order add(Order ord);
+
+    // The REST call placing the order succeeded
+    void acknowledge(const std::string_view &linkId, const std::string &orderId);
+
+    // The REST call placing the order failed
+    void reject(const std::string_view &linkId);
+
+    // Applies an update of the order topic, returns nullptr for orders that are not tracked
+    const ManagedOrder *onExecutionReport(const std::string_view &linkId, const std::string_view &orderStatus,
+                                          const long &filledQty);
+
+    void remove(const std::string_view &linkId);
+
+    void clear();
+
+    [[nodiscard]] size_t workingOrders() const;
+};
+
+#endif  // BYTRA_ORDERMANAGER_H
@@ -0,0 +1,106 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "RateLimiter.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include "AsyncLogger.h"
+
+using namespace std::chrono;
+
+RateLimiter::RateLimiter(Clock clock) : clock(std::move(clock)) {}
+
+long RateLimiter::reserve(const Bucket &bucket, const RequestPriority &priority) {
+    switch (priority) {
+        case RequestPriority::Critical:
+            return 0;
+        case RequestPriority::Order:
+            return bucket.limit / 10;
+        case RequestPriority::Amend:
+            return bucket.limit / 4;
+        case RequestPriority::Backfill:
+            return bucket.limit / 2;
+    }
+
+    return 0;
+}
+
+bool RateLimiter::tryAcquire(const std::string &endpoint, const RequestPriority &priority) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = buckets.find(endpoint);
+
+    if (it == buckets.end()) {
+        return true;
+    }
+
+    Bucket &bucket = it->second;
+
+    // Refill locally until a response announces the next window
+    if (auto now = clock(); now >= bucket.reset) {
+        bucket.remaining = bucket.limit;
+        bucket.reset = now + bucket.window;
+    }
+
+    if (bucket.remaining <= reserve(bucket, priority)) {
+        return false;
+    }
+
+    bucket.remaining--;
+    return true;
+}
+
+void RateLimiter::acquire(const std::string &endpoint, const RequestPriority &priority) {
+    while (!tryAcquire(endpoint, priority)) {
+        BYTRA_LOG_DEBUG("RateLimiter - waiting for the rate limit of {}", endpoint);
+        std::this_thread::sleep_for(milliseconds(50));
+    }
+}
+
+void RateLimiter::update(const std::string &endpoint, const long &limit, const long &remaining,
+                         const long &resetMs) {
+    Bucket parsed;
+    parsed.limit = limit;
+    parsed.remaining = remaining;
+    parsed.reset = system_clock::time_point(milliseconds(resetMs));
+    parsed.window = std::max(duration_cast<milliseconds>(parsed.reset - clock()), milliseconds(1000));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    buckets[endpoint] = parsed;
+}
+
+bool RateLimiter::update(const std::string &endpoint, const simdjson::dom::element &response) {
+    int64_t limit;
+    int64_t remaining;
+    int64_t resetMs;
+
+    if (response["rate_limit"].get(limit) || response["rate_limit_status"].get(remaining)
+        || response["rate_limit_reset_ms"].get(resetMs)) {
+        return false;
+    }
+
+    update(endpoint, limit, remaining, resetMs);
+    return true;
+}
+
+bool RateLimiter::update(const std::string &endpoint, const cpr::Header &header) {
+    auto limit = header.find("X-Bapi-Limit");
+    auto status = header.find("X-Bapi-Limit-Status");
+    auto reset = header.find("X-Bapi-Limit-Reset-Timestamp");
+
+    if (limit == header.end() || status == header.end() || reset == header.end()) {
+        return false;
+    }
+
+    try {
+        update(endpoint, std::stol(limit->second), std::stol(status->second), std::stol(reset->second));
+    } catch (const std::logic_error &) {
+        BYTRA_LOG_WARN("RateLimiter::update - invalid rate limit headers for {}", endpoint);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,63 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_RATELIMITER_H
+#define BYTRA_RATELIMITER_H
+
+#include <cpr/cpr.h>
+#include <simdjson.h>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Requests with a lower priority keep a larger part of the rate limit aside for the ones above them
+enum class RequestPriority { Critical, Order, Amend, Backfill };
+
+/** Request budget per endpoint, kept up to date with the rate limits the responses report
+ * The v2 private endpoints report their limit in the response body, newer endpoints in X-Bapi-Limit headers.
+ * Every endpoint is a token bucket of limit requests that refills when the window resets. Between responses
+ * tokens are taken locally, so a burst of requests doesn't overshoot the limit before the next header arrives.
+ * Endpoints without a response yet are not limited. The reset timestamps are exchange time, so they are compared
+ * with the clock given, the server time estimated by ClockSync in Bybit. Safe to use from several threads.
+ * */
+class RateLimiter {
+  public:
+    using Clock = std::function<std::chrono::system_clock::time_point()>;
+
+  private:
+    struct Bucket {
+        long limit = 0;
+        long remaining = 0;
+        std::chrono::system_clock::time_point reset;
+        std::chrono::milliseconds window{1000};  // time between the response and the reset it announced
+    };
+
+    Clock clock;
+    std::mutex mutex;
+    std::unordered_map<std::string, Bucket> buckets;
+
+    static long reserve(const Bucket &bucket, const RequestPriority &priority);
+
+    void update(const std::string &endpoint, const long &limit, const long &remaining, const long &resetMs);
+
+  public:
+    explicit RateLimiter(Clock clock = std::chrono::system_clock::now);
+
+    // Takes a token for a request to endpoint, false when the request has to wait for the window to reset
+    bool tryAcquire(const std::string &endpoint, const RequestPriority &priority);
+
+    // Blocks until a token for endpoint is available
+    void acquire(const std::string &endpoint, const RequestPriority &priority);
+
+    // rate_limit, rate_limit_status and rate_limit_reset_ms of a v2 response, false when the body has none
+    bool update(const std::string &endpoint, const simdjson::dom::element &response);
+
+    // X-Bapi-Limit headers, false when the response has none
+    bool update(const std::string &endpoint, const cpr::Header &header);
+};
+
+#endif  // BYTRA_RATELIMITER_H
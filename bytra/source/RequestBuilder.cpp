@@ -0,0 +1,76 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "RequestBuilder.h"
+
+#include <charconv>
+#include <cmath>
+
+void RequestBuilder::appendKey(const std::string_view &key) {
+    if (fieldsWritten++ != 0) {
+        buffer += '&';
+    }
+
+    buffer += key;
+    buffer += '=';
+}
+
+void RequestBuilder::appendValue(const std::string_view &value) { buffer += value; }
+
+void RequestBuilder::appendValue(const long &value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+void RequestBuilder::appendValue(const Decimal &value) {
+    static constexpr long powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+    long scale = powers[value.decimals];
+    long scaled = std::lround(std::abs(value.value) * scale);
+
+    if (value.value < 0 && scaled != 0) {
+        buffer += '-';
+    }
+
+    appendValue(scaled / scale);
+    long fraction = scaled % scale;
+
+    if (fraction == 0) {
+        return;
+    }
+
+    // Digits after the point, with leading zeros kept and trailing zeros dropped
+    char digits[8];
+    int length = value.decimals;
+
+    for (int i = length - 1; i >= 0; i--) {
+        digits[i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+
+    while (digits[length - 1] == '0') {
+        length--;
+    }
+
+    buffer += '.';
+    buffer.append(digits, length);
+}
+
+void RequestBuilder::appendField(const std::string_view &key, const Deferred &) {
+    if (preparedSegments == nullptr) {
+        throw std::logic_error("Deferred fields can only be used in a prepared request");
+    }
+
+    appendKey(key);
+    preparedSegments->push_back(buffer);
+    buffer.clear();
+}
+
+void RequestBuilder::appendSignature(const HmacSigner &signer) {
+    size_t length = buffer.size();
+    buffer += "&sign=";
+    size_t offset = buffer.size();
+    buffer.resize(offset + HmacSigner::signatureLength);
+    signer.sign(std::string_view(buffer.data(), length), buffer.data() + offset);
+}
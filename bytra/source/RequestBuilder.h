@@ -0,0 +1,145 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_REQUESTBUILDER_H
+#define BYTRA_REQUESTBUILDER_H
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "HmacSigner.h"
+
+/** Fixed, alphabetically sorted set of fields of a signed request
+ * Bybit signs the query string with its keys in alphabetic order. Declaring a template constexpr
+ * turns unsorted or duplicate keys into a compile error.
+ * */
+template <size_t N> struct RequestTemplate {
+    std::array<std::string_view, N> keys;
+
+    constexpr explicit RequestTemplate(const std::array<std::string_view, N> &keys) : keys(keys) {
+        for (size_t i = 1; i < N; i++) {
+            if (!(keys[i - 1] < keys[i])) {
+                throw std::logic_error("Request fields have to be sorted alphabetically");
+            }
+        }
+    }
+};
+
+// Decimal value written with at most decimals digits after the point, trailing zeros are dropped
+struct Decimal {
+    double value;
+    int decimals = 4;
+};
+
+// Placeholder for a field whose value is only known when a prepared request is sent
+struct Deferred {};
+
+/** Request of which every field except the deferred ones is already serialized
+ * Sending it only writes the deferred values between the prepared segments and signs the result.
+ * */
+class PreparedRequest {
+  private:
+    const void *requestTemplate = nullptr;
+    std::vector<std::string> segments;  // text before every deferred value, followed by the text after the last one
+
+    friend class RequestBuilder;
+
+  public:
+    template <size_t N> [[nodiscard]] bool isPreparedFrom(const RequestTemplate<N> &request) const {
+        return requestTemplate == &request;
+    }
+};
+
+/** Serializes a request template and its values into a reusable buffer and appends the signature
+ * Values are written as is, they have to be URL safe. A value wrapped in an empty std::optional leaves
+ * its field out of the request.
+ * */
+class RequestBuilder {
+  private:
+    std::string buffer;
+    size_t fieldsWritten = 0;
+    std::vector<std::string> *preparedSegments = nullptr;
+
+    void appendKey(const std::string_view &key);
+
+    void appendValue(const std::string_view &value);
+
+    void appendValue(const long &value);
+
+    void appendValue(const Decimal &value);
+
+    template <typename T> void appendField(const std::string_view &key, const T &value) {
+        appendKey(key);
+        appendValue(value);
+    }
+
+    template <typename T> void appendField(const std::string_view &key, const std::optional<T> &value) {
+        if (value) {
+            appendField(key, *value);
+        }
+    }
+
+    void appendField(const std::string_view &key, const Deferred &);
+
+    void appendSignature(const HmacSigner &signer);
+
+  public:
+    RequestBuilder() { buffer.reserve(512); }
+
+    // One value per template field, in the order of the template. The returned view is valid until the next build.
+    template <size_t N, typename... Values>
+    std::string_view build(const RequestTemplate<N> &request, const HmacSigner &signer, const Values &...values) {
+        static_assert(sizeof...(Values) == N, "One value is needed for every field of the request template");
+
+        buffer.clear();
+        fieldsWritten = 0;
+        size_t field = 0;
+        (appendField(request.keys[field++], values), ...);
+        appendSignature(signer);
+
+        return buffer;
+    }
+
+    // Like build, but fields with a Deferred value are filled in and the request is signed when it is sent
+    template <size_t N, typename... Values>
+    PreparedRequest prepare(const RequestTemplate<N> &request, const Values &...values) {
+        static_assert(sizeof...(Values) == N, "One value is needed for every field of the request template");
+
+        PreparedRequest prepared;
+        prepared.requestTemplate = &request;
+        preparedSegments = &prepared.segments;
+
+        buffer.clear();
+        fieldsWritten = 0;
+        size_t field = 0;
+        (appendField(request.keys[field++], values), ...);
+        prepared.segments.push_back(buffer);
+        preparedSegments = nullptr;
+
+        return prepared;
+    }
+
+    // One value per Deferred field, in the order of the template. The returned view is valid until the next build.
+    template <typename... Values>
+    std::string_view build(const PreparedRequest &prepared, const HmacSigner &signer, const Values &...values) {
+        if (prepared.segments.size() != sizeof...(Values) + 1) {
+            throw std::logic_error("One value is needed for every deferred field of the prepared request");
+        }
+
+        buffer.clear();
+        size_t segment = 0;
+        ((buffer += prepared.segments[segment++], appendValue(values)), ...);
+        buffer += prepared.segments.back();
+        appendSignature(signer);
+
+        return buffer;
+    }
+};
+
+#endif  // BYTRA_REQUESTBUILDER_H
@@ -0,0 +1,92 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_SERVERTIME_H
+#define BYTRA_SERVERTIME_H
+
+#include <charconv>
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/** Offset estimate of the last few measurements of the server clock
+ * Like the NTP clock filter it trusts the measurement with the shortest round trip, its offset has the
+ * smallest error bound (half the round trip).
+ * */
+class ClockFilter {
+  public:
+    struct Sample {
+        std::chrono::microseconds offset{0};
+        std::chrono::microseconds rtt{0};
+    };
+
+  private:
+    std::vector<Sample> samples;
+    size_t windowSize;  // the vector may reserve more than asked for, so its capacity is not the window
+    size_t next = 0;
+
+  public:
+    explicit ClockFilter(const size_t &size) : windowSize(size) { samples.reserve(size); }
+
+    void add(const Sample &sample) {
+        if (samples.size() < windowSize) {
+            samples.push_back(sample);
+        } else {
+            samples[next] = sample;
+            next = (next + 1) % samples.size();
+        }
+    }
+
+    [[nodiscard]] bool empty() const { return samples.empty(); }
+
+    [[nodiscard]] Sample best() const {
+        Sample best = samples.front();
+
+        for (const auto &sample : samples) {
+            if (sample.rtt < best.rtt) {
+                best = sample;
+            }
+        }
+
+        return best;
+    }
+};
+
+// Parses the time_now field of the server time endpoint, seconds with a decimal fraction
+inline std::optional<std::chrono::microseconds> parseServerTime(const std::string_view &timeNow) {
+    using namespace std::chrono;
+
+    const char *end = timeNow.data() + timeNow.size();
+    long secondsPart = 0;
+    auto result = std::from_chars(timeNow.data(), end, secondsPart);
+
+    if (result.ec != std::errc()) {
+        return std::nullopt;
+    }
+
+    microseconds time = seconds(secondsPart);
+
+    if (result.ptr != end) {
+        if (*result.ptr != '.') {
+            return std::nullopt;
+        }
+
+        // Only the first six decimals matter, shorter fractions are padded
+        long scale = 100000;
+
+        for (const char *c = result.ptr + 1; c != end; c++) {
+            if (*c < '0' || *c > '9') {
+                return std::nullopt;
+            }
+
+            time += microseconds((*c - '0') * scale);
+            scale /= 10;
+        }
+    }
+
+    return time;
+}
+
+#endif  // BYTRA_SERVERTIME_H
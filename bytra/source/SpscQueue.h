@@ -0,0 +1,65 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_SPSCQUEUE_H
+#define BYTRA_SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/** Bounded lock-free single-producer/single-consumer queue
+ * Only one thread may call push and only one (other) thread may call pop.
+ * The capacity has to be a power of two, one slot is always kept empty.
+ * */
+template <typename T, std::size_t Capacity> class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  private:
+    static constexpr std::size_t cacheLineSize = 64;
+    static constexpr std::size_t mask = Capacity - 1;
+
+    alignas(cacheLineSize) std::atomic<std::size_t> head{0};  // next slot to pop, owned by the consumer
+    alignas(cacheLineSize) std::atomic<std::size_t> tail{0};  // next slot to push, owned by the producer
+    alignas(cacheLineSize) std::array<T, Capacity> slots;
+
+  public:
+    SpscQueue() = default;
+
+    SpscQueue(const SpscQueue &) = delete;
+
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    bool push(T item) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        const std::size_t next = (t + 1) & mask;
+
+        if (next == head.load(std::memory_order_acquire)) {
+            return false;  // full
+        }
+
+        slots[t] = std::move(item);
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &item) {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;  // empty
+        }
+
+        item = std::move(slots[h]);
+        head.store((h + 1) & mask, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif  // BYTRA_SPSCQUEUE_H
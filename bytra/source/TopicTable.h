@@ -0,0 +1,109 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_TOPICTABLE_H
+#define BYTRA_TOPICTABLE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// FNV-1a, constexpr so fixed topics can be hashed at compile time
+constexpr uint64_t topicHash(std::string_view topic, uint64_t seed = 0) {
+    uint64_t hash = 14695981039346656037ULL ^ seed;
+
+    for (char c : topic) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash ^ (hash >> 32);
+}
+
+/** Perfect hash table from websocket topic to handler
+ * Topics are added when subscribing. Each time the table is rebuilt with a seed that gives every topic
+ * its own slot, so a lookup is one hash, one slot and one string compare, without temporary strings.
+ * The seed is searched at runtime rather than at compile time: the kline and order book topics contain the
+ * configured symbol and the timeframes of the strategy, so the set of topics is only known when subscribing.
+ * The search runs on (re)subscribe only, for the dozen topics of a session it finds a seed within a few tries.
+ * */
+template <typename Handler> class TopicTable {
+  private:
+    struct Entry {
+        std::string topic;
+        Handler handler{};
+        bool used = false;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<Entry> slots;
+    uint64_t seed = 0;
+    size_t mask = 0;
+
+    bool place(const size_t &size, const uint64_t &candidateSeed) {
+        std::vector<Entry> candidate(size);
+
+        for (const auto &entry : entries) {
+            Entry &slot = candidate[topicHash(entry.topic, candidateSeed) & (size - 1)];
+
+            if (slot.used) {
+                return false;
+            }
+
+            slot = entry;
+        }
+
+        slots.swap(candidate);
+        seed = candidateSeed;
+        mask = size - 1;
+        return true;
+    }
+
+    void rebuild() {
+        size_t size = 8;
+
+        while (size < entries.size() * 2) {
+            size *= 2;
+        }
+
+        for (;; size *= 2) {
+            for (uint64_t candidateSeed = 0; candidateSeed < 256; candidateSeed++) {
+                if (place(size, candidateSeed)) {
+                    return;
+                }
+            }
+        }
+    }
+
+  public:
+    void add(const std::string &topic, const Handler &handler) {
+        for (auto &entry : entries) {
+            if (entry.topic == topic) {
+                entry.handler = handler;
+                rebuild();
+                return;
+            }
+        }
+
+        entries.push_back({topic, handler, true});
+        rebuild();
+    }
+
+    void clear() {
+        entries.clear();
+        slots.clear();
+    }
+
+    [[nodiscard]] const Handler *find(const std::string_view &topic) const {
+        if (slots.empty()) {
+            return nullptr;
+        }
+
+        const Entry &slot = slots[topicHash(topic, seed) & mask];
+        return slot.used && slot.topic == topic ? &slot.handler : nullptr;
+    }
+};
+
+#endif  // BYTRA_TOPICTABLE_H
@@ -0,0 +1,17 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_TRADINGEVENT_H
+#define BYTRA_TRADINGEVENT_H
+
+// State changes that trading logic can subscribe to, combined as bit flags
+enum TradingEvent : unsigned {
+    NoEvent = 0,
+    TopOfBookChanged = 1u << 0,
+    CandleClosed = 1u << 1,
+    OrderStateChanged = 1u << 2,
+    PositionChanged = 1u << 3,
+};
+
+#endif  // BYTRA_TRADINGEVENT_H
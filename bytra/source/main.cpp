@@ -6,19 +6,22 @@
 #include <spdlog/spdlog.h>
 #include <unistd.h>
 
+#include <atomic>
+#include <boost/asio/signal_set.hpp>
 #include <chrono>
 #include <cli/CLI11.hpp>
 #include <csignal>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <toml++/toml.hpp>
 
+#include "AsyncLogger.h"
 #include "Bybit.h"
+#include "MetricsServer.h"
 #include "TerminalColors.h"
-#include "strategies/Ema.h"
-#include "strategies/Rsi.h"
-#include "strategies/Strategy.h"
+#include "strategies/Strategies.h"
 
 namespace beast = boost::beast;
 
@@ -35,14 +38,6 @@ void checkEnvVar(std::string &var) {
     }
 }
 
-void signal_callback_handler(int signum) {
-    std::cout << std::endl;
-    std::cout << "...Terminating" << std::endl;
-    spdlog::debug("Terminating program.");
-    std::cout << RED << "✗ " << RESET << "Program terminated." << std::endl;
-    exit(signum);
-}
-
 int main(int argc, char **argv) {
     std::ios_base::sync_with_stdio(false);
     std::cout << "    ____ __  __ ______ ____   ___ " << std::endl;
@@ -59,12 +54,11 @@ int main(int argc, char **argv) {
     app.add_flag("-d,--debug", d, "Debug flag that enables debug logging");
     int t{0};
     app.add_flag("-t,--testnet", t, "Testnet flag that makes it use the testnet configuration");
+    int m{0};
+    app.add_flag("-m,--mock", m, "Mock flag that makes it use the local mock exchange configuration");
 
     CLI11_PARSE(app, argc, argv)
 
-    // Register signal and signal handler
-    signal(SIGINT, signal_callback_handler);
-
     std::cout << "Setting up BYTRA" << std::endl;
     std::cout << " - Logging setup" << std::flush;
 
@@ -100,19 +94,39 @@ int main(int argc, char **argv) {
         return 1;
     }
 
-    std::map<std::string, std::shared_ptr<Strategy>> validStrategies
-        = {{"rsi", std::make_shared<Rsi>()},
-           {"ema", std::make_shared<Ema>()}};
+    // From here on log records are formatted and written on a background thread
+    std::unique_ptr<AsyncLogger> asyncLogger;
+
+    if (tbl["logging"]["async"].value_or(false)) {
+        asyncLogger = std::make_unique<AsyncLogger>();
+    }
+
+    auto &validStrategies = strategyFactories();
 
-    if (!validStrategies[strategy].get()) {
+    if (validStrategies.find(strategy) == validStrategies.end()) {
         spdlog::error("Invalid strategy: " + strategy);
         throw std::invalid_argument("Invalid strategy: " + strategy);
     }
 
+    // Parameters in [strategies.<name>] replace the defaults of the strategy
+    StrategyParameters parameters;
+
+    if (auto *table = tbl["strategies"][strategy].as_table()) {
+        for (auto &[name, value] : *table) {
+            if (!value.value<double>()) {
+                spdlog::error("Strategy parameter {} is not a number", name);
+                throw std::invalid_argument("Strategy parameter " + name + " is not a number");
+            }
+            parameters[name] = *value.value<double>();
+        }
+    }
+
+    auto tradedStrategy = validStrategies.at(strategy)(parameters);
+
     std::cout << strategy << " strategy found! " << GREEN << "✔" << RESET << std::endl;
     std::cout << " - Setting up strategy" << std::flush;
 
-    std::string configEntry = t ? "bybit-testnet" : "bybit";
+    std::string configEntry = m ? "bybit-mock" : t ? "bybit-testnet" : "bybit";
 
     std::string baseUrl = *tbl[configEntry]["baseUrl"].value<std::string>();
     std::string websocketHost = *tbl[configEntry]["websocketHost"].value<std::string>();
@@ -125,7 +139,31 @@ int main(int argc, char **argv) {
     checkEnvVar(apiSecret);
 
     auto bybit = std::make_shared<Bybit>(baseUrl, apiKey, apiSecret, websocketHost, websocketTarget,
-                                         validStrategies[strategy]);
+                                         tradedStrategy);
+
+    long maxBatchSize = tbl["engine"]["maxBatchSize"].value_or(1);
+    long batchLatencyBudgetUs = tbl["engine"]["batchLatencyBudgetUs"].value_or(0);
+    bybit->setIngestBatching(maxBatchSize, std::chrono::microseconds(batchLatencyBudgetUs));
+    bybit->setBoundaryDecisions(tbl["engine"]["boundaryDecisions"].value_or(false));
+    bybit->setRecvWindow(std::chrono::milliseconds(tbl["engine"]["recvWindowMs"].value_or(1000)));
+    bybit->setLatencyReportInterval(std::chrono::seconds(tbl["engine"]["latencyReportIntervalS"].value_or(0)));
+    spdlog::info("Server clock offset {} us, round trip {} us", bybit->getClockSync().offset().count(),
+                 bybit->getClockSync().rtt().count());
+
+    LimitOrderChaser::Settings chasing;
+    chasing.minAmendInterval = std::chrono::milliseconds(tbl["chasing"]["minAmendIntervalMs"].value_or(0));
+    chasing.tickSize = tbl["chasing"]["tickSize"].value_or(0.5);
+    chasing.hysteresisTicks = tbl["chasing"]["hysteresisTicks"].value_or(1);
+    chasing.rateLimitReserve = tbl["chasing"]["rateLimitReserve"].value_or(0);
+    bybit->setChasing(chasing);
+
+    // Served on localhost only, from a thread of its own
+    std::unique_ptr<MetricsServer> metricsServer;
+    long metricsPort = tbl["metrics"]["port"].value_or(0);
+
+    if (metricsPort > 0) {
+        metricsServer = std::make_unique<MetricsServer>(bybit->getMetrics(), static_cast<unsigned short>(metricsPort));
+    }
 
     std::cout << GREEN << " ✔" << RESET << std::endl;
 
@@ -137,45 +175,50 @@ int main(int argc, char **argv) {
 
     std::cout << "Connecting..." << std::endl;
     bybit->connect(ioc, ctx);
-    int websocketHeartbeatTimer = std::time(nullptr);
-    int websocketOrderBookSyncTimer = std::time(nullptr);
-
-    // Program Loop
-    for (;;) {
-        while (bybit->isConnected()) {
-            try {
-                bybit->readWebsocket();
-            } catch (const boost::system::system_error &err) {
-                if (err.code() == boost::asio::error::eof) {
-                    spdlog::error("boost::system::system_error: {}", err.what());
-                    break;
-                }
-
-                throw boost::system::system_error(err);
-            }
 
-            bybit->doAutomatedTrading();
-            bybit->removeUnusedCandles();
+    // Ctrl+C stops the io_context instead of exiting right away, so main can shut down in order and the log
+    // records still queued are written. The signals are waited for on a context of their own, a pending wait
+    // on ioc would keep it from running out of work when the connection is lost.
+    std::atomic<bool> terminating{false};
+    net::io_context signalContext;
+    net::signal_set signals(signalContext, SIGINT, SIGTERM);
+    signals.async_wait([&](const beast::error_code &ec, int) {
+        if (ec) {
+            return;
+        }
 
-            int currentTime = std::time(nullptr);
+        std::cout << std::endl << "...Terminating" << std::endl;
+        terminating = true;
+        ioc.stop();
+    });
+    std::thread signalThread([&signalContext] { signalContext.run(); });
 
-            // Send heartbeat packet every 45 seconds to maintain websocket connection
-            if (currentTime - websocketHeartbeatTimer > 45) {
-                websocketHeartbeatTimer = currentTime;
-                bybit->sendWebsocketHeartbeat();
-            }
+    // Program Loop
+    while (!terminating) {
+        // Websocket reads and the heartbeat, order book sync and stop loss timers are all driven by the
+        // io_context. It runs out of work when the websocket connection is lost.
+        ioc.run();
 
-            // Sync order book after an hour
-            if (currentTime - websocketOrderBookSyncTimer > 3600) {
-                websocketOrderBookSyncTimer = currentTime;
-                bybit->syncOrderBook();
-            }
+        if (terminating) {
+            break;
         }
+
         sleep(3);
         std::cout << "Attempting to reconnect..." << std::endl;
         bybit->disconnect();
+        ioc.restart();
         bybit->connect(ioc, ctx);
     }
 
+    signalThread.join();
+    spdlog::debug("Terminating program.");
+
+    // Stops the metrics server, then Bybit joins its threads, the async logger goes last and writes what is queued
+    bybit->disconnect();
+    metricsServer.reset();
+    bybit.reset();
+    asyncLogger.reset();
+
+    std::cout << RED << "✗ " << RESET << "Program terminated." << std::endl;
     return 0;
 }
@@ -7,41 +7,46 @@
 #include <spdlog/spdlog.h>
 #include <ta-lib/ta_libc.h>
 
-Ema::Ema() {
+Ema::Ema(const int &fastPeriod, const int &slowPeriod, const double &stopLossPercentage)
+    : fastPeriod(fastPeriod), slowPeriod(slowPeriod), fastEma(fastPeriod), slowEma(slowPeriod) {
     /** EMA strategy
      * An exponential moving average (EMA) is a type of moving average (MA)
      * that places a greater weight and significance on the most recent data points.
-     * We use the 20-EMA and 50-EMA and consider the moment when the 20-EMA crosses above the 50-EMA
-     * a buy signal. The sell signal is when the 20-EMA crosses below the 50-EMA.
+     * We use the 20-EMA and 50-EMA by default and consider the moment when the fast EMA crosses above the
+     * slow EMA a buy signal. The sell signal is when the fast EMA crosses below the slow EMA.
      * */
+    if (fastPeriod < 1 || fastPeriod >= slowPeriod || !(0 < stopLossPercentage && stopLossPercentage < 1)) {
+        throw std::invalid_argument("Invalid EMA parameters.");
+    }
+
     name = "EMA";
     timeframes = {{"1", 1000}};
     symbol = "BTCUSD";
     qty = 100;
     orderType = "Market";
     slippage = 10.0;
-    stopLossPercentage = 0.03;
+    this->stopLossPercentage = stopLossPercentage;
 }
 
 bool Ema::checkLongEntry(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles) {
-    // calculate 20-EMA values
-    auto [currEmaValue, prevEmaValue] = calculateEMA(candles, 20);
+    // calculate fast EMA values
+    auto [currEmaValue, prevEmaValue] = calculateEMA(candles, fastPeriod);
 
-    // calculate 50-EMA values
-    auto [currEmaValue2, prevEmaValue2] = calculateEMA(candles, 50);
+    // calculate slow EMA values
+    auto [currEmaValue2, prevEmaValue2] = calculateEMA(candles, slowPeriod);
 
-    // check if 20-EMA crossed above 50-EMA
+    // check if the fast EMA crossed above the slow EMA
     return (prevEmaValue < prevEmaValue2 && currEmaValue > currEmaValue2);
 }
 
 bool Ema::checkShortEntry(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles) {
-    // calculate 20-EMA values
-    auto [currEmaValue, prevEmaValue] = calculateEMA(candles, 20);
+    // calculate fast EMA values
+    auto [currEmaValue, prevEmaValue] = calculateEMA(candles, fastPeriod);
 
-    // calculate 50-EMA values
-    auto [currEmaValue2, prevEmaValue2] = calculateEMA(candles, 50);
+    // calculate slow EMA values
+    auto [currEmaValue2, prevEmaValue2] = calculateEMA(candles, slowPeriod);
 
-    // check if 20-EMA crossed below 50-EMA
+    // check if the fast EMA crossed below the slow EMA
     return (prevEmaValue > prevEmaValue2 && currEmaValue < currEmaValue2);
 }
 
@@ -50,6 +55,36 @@ bool Ema::checkExit(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &c
     return ((position->isLong() && checkShortEntry(candles)) || (position->isShort() && checkLongEntry(candles)));
 }
 
+bool Ema::updateTriggerLevels(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
+                              TriggerLevels &levels) {
+    auto tf = TimeFrame(timeframes[0].first, timeframes[0].second);
+
+    for (auto &candle : candles[tf]) {
+        if (candle->timestamp > lastTimestamp) {
+            fastEma.update(candle->close);
+            slowEma.update(candle->close);
+            lastTimestamp = candle->timestamp;
+        }
+    }
+
+    // Both averages move linearly with the next close, the fast one faster, so they cross at a single price
+    double fastAlpha = fastEma.getAlpha();
+    double slowAlpha = slowEma.getAlpha();
+    double crossPrice
+        = ((1 - slowAlpha) * slowEma.value() - (1 - fastAlpha) * fastEma.value()) / (fastAlpha - slowAlpha);
+    double diff = fastEma.value() - slowEma.value();
+
+    PriceTrigger crossAbove = diff < 0 ? PriceTrigger{PriceTrigger::Above, crossPrice} : PriceTrigger{};
+    PriceTrigger crossBelow = diff > 0 ? PriceTrigger{PriceTrigger::Below, crossPrice} : PriceTrigger{};
+
+    levels.longEntry = crossAbove;
+    levels.shortEntry = crossBelow;
+    levels.longExit = crossBelow;
+    levels.shortExit = crossAbove;
+
+    return slowEma.ready();
+}
+
 std::pair<double, double> Ema::calculateEMA(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
                                             const int &timePeriod) {
     auto tf = TimeFrame(timeframes[0].first, timeframes[0].second);
@@ -5,11 +5,19 @@
 #ifndef BYTRA_EMA_H
 #define BYTRA_EMA_H
 
+#include "Indicators.h"
 #include "Strategy.h"
 
 class Ema : public Strategy {
+  private:
+    int fastPeriod;
+    int slowPeriod;
+    ExponentialMovingAverage fastEma;
+    ExponentialMovingAverage slowEma;
+    long lastTimestamp = 0;  // last candle added to the averages
+
   public:
-    Ema();
+    explicit Ema(const int &fastPeriod = 20, const int &slowPeriod = 50, const double &stopLossPercentage = 0.03);
 
     bool checkLongEntry(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles) override;
 
@@ -18,6 +26,9 @@ class Ema : public Strategy {
     bool checkExit(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
                    std::shared_ptr<Position> position) override;
 
+    bool updateTriggerLevels(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
+                             TriggerLevels &levels) override;
+
     std::pair<double, double> calculateEMA(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
                                            const int &timePeriod);
 };
@@ -0,0 +1,97 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_INDICATORS_H
+#define BYTRA_INDICATORS_H
+
+#include <algorithm>
+
+/** Relative strength index with Wilder's smoothing, updated one close at a time
+ * The first average gain and loss are the simple mean of the first period changes, like TA_RSI.
+ * */
+class WilderRsi {
+  private:
+    int period;
+    long count = 0;  // closes seen
+    double prevClose = 0;
+    double avgGain = 0;
+    double avgLoss = 0;
+
+  public:
+    explicit WilderRsi(const int &period) : period(period) {}
+
+    void update(const double &close) {
+        if (count++ == 0) {
+            prevClose = close;
+            return;
+        }
+
+        double gain = std::max(close - prevClose, 0.0);
+        double loss = std::max(prevClose - close, 0.0);
+        prevClose = close;
+
+        if (count <= period) {
+            avgGain += gain / period;
+            avgLoss += loss / period;
+        } else {
+            avgGain = (avgGain * (period - 1) + gain) / period;
+            avgLoss = (avgLoss * (period - 1) + loss) / period;
+        }
+    }
+
+    [[nodiscard]] bool ready() const { return count > period; }
+
+    [[nodiscard]] double value() const {
+        if (avgLoss == 0) {
+            return avgGain == 0 ? 50 : 100;
+        }
+
+        return 100 - 100 / (1 + avgGain / avgLoss);
+    }
+
+    // Close price at which the next update gives the target RSI, the RSI rises with the close
+    [[nodiscard]] double closeFor(const double &target) const {
+        double gains = avgGain * (period - 1);
+        double losses = avgLoss * (period - 1);
+        double rs = target / (100 - target);
+
+        if (rs * losses >= gains) {
+            return prevClose + rs * losses - gains;
+        }
+
+        return prevClose - (gains / rs - losses);
+    }
+};
+
+/** Exponential moving average, updated one close at a time
+ * Seeded with the simple average of the first period closes, like TA_EMA.
+ * */
+class ExponentialMovingAverage {
+  private:
+    int period;
+    double alpha;
+    long count = 0;
+    double ema = 0;
+
+  public:
+    explicit ExponentialMovingAverage(const int &period) : period(period), alpha(2.0 / (period + 1)) {}
+
+    void update(const double &close) {
+        if (count++ < period) {
+            ema += close / period;
+        } else {
+            ema = next(close);
+        }
+    }
+
+    [[nodiscard]] bool ready() const { return count >= period; }
+
+    [[nodiscard]] double value() const { return ema; }
+
+    [[nodiscard]] double next(const double &close) const { return alpha * close + (1 - alpha) * ema; }
+
+    [[nodiscard]] double getAlpha() const { return alpha; }
+};
+
+#endif  // BYTRA_INDICATORS_H
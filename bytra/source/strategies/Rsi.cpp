@@ -7,7 +7,8 @@
 #include <spdlog/spdlog.h>
 #include <ta-lib/ta_libc.h>
 
-Rsi::Rsi() {
+Rsi::Rsi(const int &length, const double &oversold, const double &overbought, const double &stopLossPercentage)
+    : length(length), oversold(oversold), overbought(overbought), rsi(length) {
     /** RSI strategy
      * The relative strength index (RSI) is most commonly used to indicate temporarily
      * overbought or oversold conditions in a market.
@@ -16,21 +17,26 @@ Rsi::Rsi() {
      * oversold conditions when RSI readings are under 30.
      * We buy when the market is oversold and sell when the market is overbought.
      * */
+    if (length < 2 || !(0 < oversold && oversold < 50 && 50 < overbought && overbought < 100)
+        || !(0 < stopLossPercentage && stopLossPercentage < 1)) {
+        throw std::invalid_argument("Invalid RSI parameters.");
+    }
+
     name = "RSI";
     timeframes = {{"1", 1000}};
     symbol = "BTCUSD";
     qty = 100;
     orderType = "Limit";
     slippage = 5.0;
-    stopLossPercentage = 0.03;
+    this->stopLossPercentage = stopLossPercentage;
 }
 
 bool Rsi::checkLongEntry(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles) {
-     return calculateRSI(candles) < 30;
+     return calculateRSI(candles) < oversold;
 }
 
 bool Rsi::checkShortEntry(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles) {
-     return calculateRSI(candles) > 70;
+     return calculateRSI(candles) > overbought;
 }
 
 bool Rsi::checkExit(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
@@ -39,6 +45,26 @@ bool Rsi::checkExit(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &c
     return (rsi_value > 50 && position->isLong()) || (rsi_value < 50 && position->isShort());
 }
 
+bool Rsi::updateTriggerLevels(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
+                              TriggerLevels &levels) {
+    auto tf = TimeFrame(timeframes[0].first, timeframes[0].second);
+
+    for (auto &candle : candles[tf]) {
+        if (candle->timestamp > lastTimestamp) {
+            rsi.update(candle->close);
+            lastTimestamp = candle->timestamp;
+        }
+    }
+
+    // RSI below oversold to go long, above overbought to go short and crossing 50 to exit
+    levels.longEntry = {PriceTrigger::Below, rsi.closeFor(oversold)};
+    levels.shortEntry = {PriceTrigger::Above, rsi.closeFor(overbought)};
+    levels.longExit = {PriceTrigger::Above, rsi.closeFor(50)};
+    levels.shortExit = {PriceTrigger::Below, rsi.closeFor(50)};
+
+    return rsi.ready();
+}
+
 double Rsi::calculateRSI(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles) {
     auto tf = TimeFrame(timeframes[0].first, timeframes[0].second);
 
@@ -51,7 +77,7 @@ double Rsi::calculateRSI(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>
 
     int endIdx = (int)close.size() - 1;
     int startIdx = endIdx - timeframes[0].second + 1;
-    int rsi_length = 10;
+    int rsi_length = length;
     int outBegIdx;
     int outNbElement;
     std::vector<double> rsi(close.size() - rsi_length);
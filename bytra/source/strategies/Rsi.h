@@ -9,11 +9,20 @@
 #include <string>
 #include <vector>
 
+#include "Indicators.h"
 #include "Strategy.h"
 
 class Rsi : public Strategy {
+  private:
+    int length;
+    double oversold;
+    double overbought;
+    WilderRsi rsi;
+    long lastTimestamp = 0;  // last candle added to rsi
+
   public:
-    Rsi();
+    explicit Rsi(const int &length = 10, const double &oversold = 30, const double &overbought = 70,
+                 const double &stopLossPercentage = 0.03);
 
     bool checkLongEntry(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles) override;
 
@@ -22,6 +31,9 @@ class Rsi : public Strategy {
     bool checkExit(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
                    std::shared_ptr<Position> position) override;
 
+    bool updateTriggerLevels(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
+                             TriggerLevels &levels) override;
+
     double calculateRSI(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles);
 };
 
@@ -0,0 +1,61 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_STRATEGIES_H
+#define BYTRA_STRATEGIES_H
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "Ema.h"
+#include "Rsi.h"
+#include "Strategy.h"
+
+using StrategyParameters = std::map<std::string, double>;
+using StrategyFactory = std::function<std::shared_ptr<Strategy>(const StrategyParameters &)>;
+
+namespace strategies {
+    // Parameters that aren't given keep the value the strategy was tuned with, unknown ones are most likely typos
+    inline void checkParameterNames(const StrategyParameters &parameters, std::initializer_list<std::string> names) {
+        for (auto &[name, value] : parameters) {
+            if (std::find(names.begin(), names.end(), name) == names.end()) {
+                throw std::invalid_argument("Unknown strategy parameter: " + name);
+            }
+        }
+    }
+
+    inline double parameter(const StrategyParameters &parameters, const std::string &name, const double &fallback) {
+        auto it = parameters.find(name);
+        return it == parameters.end() ? fallback : it->second;
+    }
+}  // namespace strategies
+
+// Strategies by the name they are selected with, invalid parameters throw std::invalid_argument
+inline const std::map<std::string, StrategyFactory> &strategyFactories() {
+    using strategies::parameter;
+
+    static const std::map<std::string, StrategyFactory> factories = {
+        {"rsi",
+         [](const StrategyParameters &p) {
+             strategies::checkParameterNames(p, {"length", "oversold", "overbought", "stopLossPercentage"});
+             return std::make_shared<Rsi>(int(parameter(p, "length", 10)), parameter(p, "oversold", 30),
+                                          parameter(p, "overbought", 70), parameter(p, "stopLossPercentage", 0.03));
+         }},
+        {"ema",
+         [](const StrategyParameters &p) {
+             strategies::checkParameterNames(p, {"fastPeriod", "slowPeriod", "stopLossPercentage"});
+             return std::make_shared<Ema>(int(parameter(p, "fastPeriod", 20)), int(parameter(p, "slowPeriod", 50)),
+                                          parameter(p, "stopLossPercentage", 0.03));
+         }},
+    };
+
+    return factories;
+}
+
+#endif  // BYTRA_STRATEGIES_H
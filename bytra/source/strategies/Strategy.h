@@ -14,6 +14,25 @@
 #include "../Order.h"
 #include "../Position.h"
 
+// Fires when the close price of the next candle ends up below or above price
+struct PriceTrigger {
+    enum Side { Never, Below, Above };
+
+    Side side = Never;
+    double price = 0;
+
+    [[nodiscard]] bool firesAt(const double &close) const {
+        return (side == Below && close < price) || (side == Above && close > price);
+    }
+};
+
+struct TriggerLevels {
+    PriceTrigger longEntry;
+    PriceTrigger shortEntry;
+    PriceTrigger longExit;
+    PriceTrigger shortExit;
+};
+
 class Strategy {
   protected:
     std::string name;
@@ -33,6 +52,16 @@ class Strategy {
                            std::shared_ptr<Position> position)
         = 0;
 
+    /** Close prices at which the signals fire on the candle after the last closed one
+     * Called after every closed candle, so the indicators can be updated incrementally and the decision at
+     * the next close is a single comparison. Returns false when the strategy can't express its signals
+     * as price levels (yet), checkLongEntry and friends are used then.
+     * */
+    virtual bool updateTriggerLevels(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> & /*candles*/,
+                                     TriggerLevels & /*levels*/) {
+        return false;
+    }
+
     std::string getName() { return name; }
 
     std::vector<std::pair<std::string, int>> getTimeframes() { return timeframes; }
@@ -0,0 +1,83 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "MarketReplay.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+namespace {
+    std::vector<std::string> readLines(const std::string &path) {
+        std::ifstream file(path);
+
+        if (!file) {
+            throw std::runtime_error("Missing fixture: " + path);
+        }
+
+        std::vector<std::string> lines;
+        std::string line;
+
+        while (std::getline(file, line)) {
+            if (!line.empty()) {
+                lines.push_back(line);
+            }
+        }
+
+        return lines;
+    }
+}  // namespace
+
+MarketReplay::MarketReplay(const std::string &fixturesDir, const std::string &symbol) {
+    simdjson::dom::parser parser;
+    std::vector<std::pair<int64_t, ReplayFrame>> timestamped;
+
+    for (const std::string &topic : {"orderBookL2_25." + symbol, "klineV2.1." + symbol}) {
+        for (auto &line : readLines(fixturesDir + "/" + topic + ".jsonl")) {
+            simdjson::dom::element msg = parser.parse(line);
+
+            if (topic.rfind("klineV2.", 0) == 0) {
+                simdjson::dom::object kline = msg["data"].at(0);
+
+                if (bool(kline["confirm"])) {
+                    continue;
+                }
+
+                if (firstPrice == 0) {
+                    firstPrice = double(kline["open"]);
+                }
+            }
+
+            int64_t timestamp = msg["timestamp_e6"];
+            timestamped.push_back({timestamp, {std::make_shared<const simdjson::padded_string>(line), topic, {}}});
+        }
+    }
+
+    if (timestamped.empty() || firstPrice == 0) {
+        throw std::runtime_error("No recorded messages for " + symbol);
+    }
+
+    // The snapshot is the first order book message, it goes first whatever its timestamp
+    std::stable_sort(timestamped.begin() + 1, timestamped.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    int64_t start = std::min(timestamped.front().first, timestamped[1].first);
+
+    for (auto &[timestamp, frame] : timestamped) {
+        frame.offset = microseconds(std::max<int64_t>(timestamp - start, 0));
+        frames.push_back(std::move(frame));
+    }
+}
+
+Candle MarketReplay::candle(const long &index, const long &origin, const double &center, const int &halfPeriod) {
+    long phase = ((index % (2 * halfPeriod)) + 2 * halfPeriod) % (2 * halfPeriod);
+    long fromTop = phase < halfPeriod ? phase : 2 * halfPeriod - phase;
+
+    double close = center + (halfPeriod / 2.0 - fromTop);
+    double open = close + (phase < halfPeriod ? 1.0 : -1.0);
+
+    return Candle{open, std::max(open, close) + 0.5, std::min(open, close) - 0.5, close, 1000, origin + index * 60};
+}
@@ -0,0 +1,49 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_MARKETREPLAY_H
+#define BYTRA_MARKETREPLAY_H
+
+#include <simdjson.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../bytra/source/Candle.h"
+
+struct ReplayFrame {
+    std::shared_ptr<const simdjson::padded_string> payload;  // padded, so it can be parsed in place
+    std::string topic;
+    std::chrono::microseconds offset;  // since the first frame of the recording
+};
+
+/** Recorded orderBookL2_25 and klineV2 messages of one symbol, merged in the order they were received
+ * The first frame is the order book snapshot, so the replay can start over from the beginning at any time.
+ * Confirmed klines are left out, the candles that close are generated by candle() instead: recorded ones
+ * would go back in time every time the replay starts over.
+ * */
+class MarketReplay {
+  private:
+    std::vector<ReplayFrame> frames;
+    double firstPrice = 0;
+
+  public:
+    MarketReplay(const std::string &fixturesDir, const std::string &symbol);
+
+    [[nodiscard]] const std::vector<ReplayFrame> &getFrames() const { return frames; }
+
+    // Open price of the first recorded kline
+    [[nodiscard]] double getFirstPrice() const { return firstPrice; }
+
+    /** One minute candle number index, negative indices are the history before the replay started
+     * The close zigzags around center, halfPeriod candles down and halfPeriod up, so RSI and EMA crossings happen
+     * every few candles instead of a few times a day.
+     * */
+    [[nodiscard]] static Candle candle(const long &index, const long &origin, const double &center,
+                                       const int &halfPeriod = 12);
+};
+
+#endif  // BYTRA_MARKETREPLAY_H
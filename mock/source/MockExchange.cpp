@@ -0,0 +1,885 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include "MockExchange.h"
+
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <boost/asio/post.hpp>
+#include <boost/asio/ssl/stream.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/websocket.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include <charconv>
+#include <cmath>
+#include <deque>
+#include <future>
+#include <set>
+#include <stdexcept>
+
+#include "NetworkDelay.h"
+
+namespace beast = boost::beast;          // from <boost/beast.hpp>
+namespace http = beast::http;            // from <boost/beast/http.hpp>
+namespace websocket = beast::websocket;  // from <boost/beast/websocket.hpp>
+using namespace std::chrono;
+
+namespace {
+    const std::string createOrderRoute = "/v2/private/order/create";
+    const std::string replaceOrderRoute = "/open-api/order/replace";
+    const std::string cancelOrderRoute = "/v2/private/order/cancel";
+    const std::string cancelAllRoute = "/v2/private/order/cancelAll";
+    const std::string tradingStopRoute = "/v2/private/position/trading-stop";
+    const std::string positionListRoute = "/v2/private/position/list";
+    const std::string klineRoute = "/v2/public/kline/list";
+    const std::string serverTimeRoute = "/v2/public/time";
+
+    // The client doesn't verify the certificate, a fresh self-signed one saves shipping a key with the repo
+    void useSelfSignedCertificate(ssl::context &ctx) {
+        std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> keyContext(
+            EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr), EVP_PKEY_CTX_free);
+        EVP_PKEY *generated = nullptr;
+
+        if (!keyContext || EVP_PKEY_keygen_init(keyContext.get()) <= 0
+            || EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyContext.get(), NID_X9_62_prime256v1) <= 0
+            || EVP_PKEY_keygen(keyContext.get(), &generated) <= 0) {
+            throw std::runtime_error("Generating the TLS key failed.");
+        }
+
+        std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> key(generated, EVP_PKEY_free);
+        std::unique_ptr<X509, decltype(&X509_free)> certificate(X509_new(), X509_free);
+
+        ASN1_INTEGER_set(X509_get_serialNumber(certificate.get()), 1);
+        X509_gmtime_adj(X509_getm_notBefore(certificate.get()), 0);
+        X509_gmtime_adj(X509_getm_notAfter(certificate.get()), 60 * 60 * 24);
+        X509_set_pubkey(certificate.get(), key.get());
+
+        X509_NAME *name = X509_get_subject_name(certificate.get());
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char *>("localhost"), -1,
+                                   -1, 0);
+        X509_set_issuer_name(certificate.get(), name);
+
+        if (X509_sign(certificate.get(), key.get(), EVP_sha256()) <= 0
+            || SSL_CTX_use_certificate(ctx.native_handle(), certificate.get()) != 1
+            || SSL_CTX_use_PrivateKey(ctx.native_handle(), key.get()) != 1) {
+            throw std::runtime_error("Setting up the TLS certificate failed.");
+        }
+    }
+
+    long nowMs() { return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count(); }
+
+    std::string timeNow() {
+        return fmt::format("{:.6f}", duration_cast<microseconds>(system_clock::now().time_since_epoch()).count() / 1e6);
+    }
+
+    // Query strings and form bodies, values are used as is
+    std::map<std::string_view, std::string_view> parseParams(std::string_view query) {
+        std::map<std::string_view, std::string_view> params;
+
+        while (!query.empty()) {
+            auto end = query.find('&');
+            std::string_view field = query.substr(0, end);
+
+            if (auto separator = field.find('='); separator != std::string_view::npos) {
+                params[field.substr(0, separator)] = field.substr(separator + 1);
+            }
+
+            query = end == std::string_view::npos ? std::string_view() : query.substr(end + 1);
+        }
+
+        return params;
+    }
+
+    long toLong(const std::string_view &value) {
+        long result = 0;
+        std::from_chars(value.data(), value.data() + value.size(), result);
+        return result;
+    }
+
+    double toDouble(const std::string_view &value) { return std::strtod(std::string(value).c_str(), nullptr); }
+
+    std::string apiResponse(const int &retCode, const std::string_view &retMsg, const std::string_view &result) {
+        return fmt::format(R"({{"ret_code":{},"ret_msg":"{}","ext_code":"","ext_info":"","result":{},"time_now":"{}"}})",
+                           retCode, retMsg, result, timeNow());
+    }
+
+    std::shared_ptr<const simdjson::padded_string> frame(const std::string &msg) {
+        return std::make_shared<const simdjson::padded_string>(msg);
+    }
+}  // namespace
+
+/** Websocket connection of a client, frames are written in order, each once its injected delay passed */
+class MockExchange::WebsocketSession : public std::enable_shared_from_this<WebsocketSession> {
+  private:
+    MockExchange &exchange;
+    websocket::stream<ssl::stream<tcp::socket>> ws;
+    beast::flat_buffer buffer;
+    NetworkDelay delay;
+    net::steady_timer sendTimer;
+    std::deque<std::pair<steady_clock::time_point, std::shared_ptr<const simdjson::padded_string>>> outbox;
+    bool writing = false;
+    bool open = true;
+    std::set<std::string, std::less<>> topics;
+
+    void read() {
+        ws.async_read(buffer, [self = shared_from_this()](const beast::error_code &ec, size_t) {
+            if (ec) {
+                self->open = false;
+                return;
+            }
+
+            std::string msg = beast::buffers_to_string(self->buffer.data());
+            self->buffer.consume(self->buffer.size());
+            self->exchange.onWebsocketMessage(*self, msg);
+            self->read();
+        });
+    }
+
+    void writeNext() {
+        if (outbox.empty() || !open) {
+            writing = false;
+            return;
+        }
+
+        writing = true;
+        sendTimer.expires_at(outbox.front().first);
+        sendTimer.async_wait([self = shared_from_this()](const beast::error_code &ec) {
+            if (ec) {
+                return;
+            }
+
+            auto &payload = *self->outbox.front().second;
+            self->ws.async_write(net::buffer(payload.data(), payload.size()),
+                                 [self](const beast::error_code &ec, size_t bytes) {
+                                     if (ec) {
+                                         self->open = false;
+                                         return;
+                                     }
+
+                                     self->exchange.onFrameSent(bytes);
+                                     self->outbox.pop_front();
+                                     self->writeNext();
+                                 });
+        });
+    }
+
+  public:
+    WebsocketSession(MockExchange &exchange, tcp::socket socket, const unsigned long &seed)
+        : exchange(exchange),
+          ws(std::move(socket), exchange.sslContext),
+          delay(exchange.settings.delay, exchange.settings.jitter, seed),
+          sendTimer(exchange.ioc) {}
+
+    void start() {
+        ws.next_layer().async_handshake(ssl::stream_base::server, [self = shared_from_this()](
+                                                                      const beast::error_code &ec) {
+            if (ec) {
+                spdlog::warn("[Mock] TLS handshake failed: {}", ec.message());
+                return;
+            }
+
+            self->ws.async_accept([self](const beast::error_code &ec) {
+                if (ec) {
+                    spdlog::warn("[Mock] websocket handshake failed: {}", ec.message());
+                    return;
+                }
+
+                spdlog::info("[Mock] Websocket client connected");
+                self->read();
+            });
+        });
+    }
+
+    void send(std::shared_ptr<const simdjson::padded_string> payload) {
+        outbox.emplace_back(delay.deliveryTime(), std::move(payload));
+
+        if (!writing) {
+            writeNext();
+        }
+    }
+
+    void subscribe(const std::string_view &topic) { topics.emplace(topic); }
+
+    [[nodiscard]] bool isSubscribed(const std::string_view &topic) const { return topics.find(topic) != topics.end(); }
+
+    [[nodiscard]] bool isOpen() const { return open; }
+
+    [[nodiscard]] size_t backlog() const { return outbox.size(); }
+};
+
+/** Keep-alive HTTP connection of a client, one request at a time like a cpr session sends them */
+class MockExchange::RestSession : public std::enable_shared_from_this<RestSession> {
+  private:
+    MockExchange &exchange;
+    beast::tcp_stream stream;
+    beast::flat_buffer buffer;
+    http::request<http::string_body> request;
+    http::response<http::string_body> response;
+    NetworkDelay delay;
+    net::steady_timer sendTimer;
+
+    void read() {
+        request = {};
+        http::async_read(stream, buffer, request, [self = shared_from_this()](const beast::error_code &ec, size_t) {
+            if (!ec) {
+                self->respond();
+            }
+        });
+    }
+
+    void respond() {
+        auto target = request.target();
+        RestResponse handled = exchange.handleRest(std::string(request.method_string()),
+                                                   std::string_view(target.data(), target.size()), request.body());
+
+        response = {};
+        response.version(request.version());
+        response.keep_alive(request.keep_alive());
+        response.result(handled.status);
+        response.set(http::field::content_type, "application/json");
+
+        if (handled.rateLimitStatus >= 0) {
+            response.set("X-Bapi-Limit", std::to_string(rateLimit));
+            response.set("X-Bapi-Limit-Status", std::to_string(handled.rateLimitStatus));
+            response.set("X-Bapi-Limit-Reset-Timestamp", std::to_string(handled.rateLimitResetMs));
+        }
+
+        response.body() = std::move(handled.body);
+        response.prepare_payload();
+
+        sendTimer.expires_at(delay.deliveryTime());
+        sendTimer.async_wait([self = shared_from_this(), signalTime = handled.signalTime](const beast::error_code &ec) {
+            if (ec) {
+                return;
+            }
+
+            http::async_write(self->stream, self->response, [self, signalTime](const beast::error_code &ec, size_t) {
+                if (ec) {
+                    return;
+                }
+
+                if (signalTime) {
+                    self->exchange.signalToAck.record(steady_clock::now() - *signalTime);
+                }
+
+                if (self->response.keep_alive()) {
+                    self->read();
+                } else {
+                    beast::error_code ignored;
+                    self->stream.socket().shutdown(tcp::socket::shutdown_send, ignored);
+                }
+            });
+        });
+    }
+
+  public:
+    RestSession(MockExchange &exchange, tcp::socket socket, const unsigned long &seed)
+        : exchange(exchange),
+          stream(std::move(socket)),
+          delay(exchange.settings.delay, exchange.settings.jitter, seed),
+          sendTimer(exchange.ioc) {}
+
+    void start() { read(); }
+};
+
+MockExchange::MockExchange(Settings settings, const std::string &fixturesDir)
+    : settings(std::move(settings)),
+      replay(fixturesDir, this->settings.symbol),
+      signer(this->settings.apiSecret),
+      restAcceptor(ioc, tcp::endpoint(net::ip::address_v4::loopback(), this->settings.restPort)),
+      websocketAcceptor(ioc, tcp::endpoint(net::ip::address_v4::loopback(), this->settings.websocketPort)),
+      replayTimer(ioc),
+      candleTimer(ioc) {
+    useSelfSignedCertificate(sslContext);
+
+    book = std::make_shared<OrderBook>();
+    bookParser = std::make_unique<MarketDataParser>(
+        book, [](const std::string_view &, const Candle &) {},
+        [](const std::string_view &error) { spdlog::warn("[Mock] Invalid order book fixture: {}", error); });
+    bookParser->addTopic("orderBookL2_25." + this->settings.symbol);
+
+    // Candle 0 is the first one closed by the mock, the ones before it are served as history
+    candleOrigin = duration_cast<minutes>(system_clock::now().time_since_epoch()).count() * 60;
+    started = steady_clock::now();
+
+    spdlog::info("[Mock] REST on http://127.0.0.1:{}, websocket on wss://127.0.0.1:{}", this->settings.restPort,
+                 this->settings.websocketPort);
+
+    acceptRest();
+    acceptWebsocket();
+    startCandleTimer();
+    thread = std::thread([this] { ioc.run(); });
+}
+
+MockExchange::~MockExchange() {
+    ioc.stop();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+std::string MockExchange::report() {
+    std::promise<std::string> result;
+    auto future = result.get_future();
+    net::post(ioc, [this, &result] { result.set_value(renderReport()); });
+
+    return future.get();
+}
+
+void MockExchange::acceptWebsocket() {
+    websocketAcceptor.async_accept([this](const beast::error_code &ec, tcp::socket socket) {
+        if (!ec) {
+            socket.set_option(tcp::no_delay(true));
+            auto session = std::make_shared<WebsocketSession>(*this, std::move(socket), sessions.size() + 1);
+            sessions.erase(std::remove_if(sessions.begin(), sessions.end(), [](auto &s) { return s.expired(); }),
+                           sessions.end());
+            sessions.push_back(session);
+            session->start();
+        }
+
+        acceptWebsocket();
+    });
+}
+
+void MockExchange::acceptRest() {
+    restAcceptor.async_accept([this](const beast::error_code &ec, tcp::socket socket) {
+        static unsigned long connections = 0;
+
+        if (!ec) {
+            socket.set_option(tcp::no_delay(true));
+            std::make_shared<RestSession>(*this, std::move(socket), 1000 + ++connections)->start();
+        }
+
+        acceptRest();
+    });
+}
+
+void MockExchange::startReplay() {
+    replayPosition = 0;
+    replayStart = steady_clock::now();
+
+    // A wait that already completed can't be cancelled anymore, the generation tells it to stop
+    replayGeneration++;
+    replayTimer.cancel();
+    scheduleReplay();
+}
+
+void MockExchange::scheduleReplay() {
+    if (settings.replaySpeed > 0) {
+        auto offset = replay.getFrames()[replayPosition].offset;
+        replayTimer.expires_at(replayStart + microseconds(static_cast<long>(offset.count() / settings.replaySpeed)));
+    } else {
+        replayTimer.expires_after(microseconds(0));
+    }
+
+    replayTimer.async_wait([this, generation = replayGeneration](const beast::error_code &ec) {
+        if (!ec && generation == replayGeneration) {
+            replayNext();
+        }
+    });
+}
+
+void MockExchange::replayNext() {
+    size_t backlog = 0;
+    bool subscribed = false;
+
+    for (auto &weak : sessions) {
+        if (auto session = weak.lock(); session && session->isOpen()) {
+            backlog = std::max(backlog, session->backlog());
+            subscribed = true;
+        }
+    }
+
+    if (!subscribed) {
+        return;
+    }
+
+    // As fast as the client reads, without letting frames pile up
+    if (settings.replaySpeed <= 0 && backlog >= maxBacklog) {
+        replayTimer.expires_after(microseconds(100));
+        replayTimer.async_wait([this, generation = replayGeneration](const beast::error_code &ec) {
+            if (!ec && generation == replayGeneration) {
+                replayNext();
+            }
+        });
+        return;
+    }
+
+    const ReplayFrame &next = replay.getFrames()[replayPosition];
+
+    if (bookParser->parse(reinterpret_cast<const uint8_t *>(next.payload->data()), next.payload->size())) {
+        matchWorkingOrders();
+    }
+
+    publish(next.topic, next.payload);
+    replayedFrames++;
+
+    // The replay starts over from the snapshot once the recording ran out
+    if (++replayPosition == replay.getFrames().size()) {
+        replayPosition = 0;
+        replayStart = steady_clock::now();
+    }
+
+    scheduleReplay();
+}
+
+void MockExchange::startCandleTimer() {
+    candleTimer.expires_after(settings.candleInterval);
+    candleTimer.async_wait([this](const beast::error_code &ec) {
+        if (!ec) {
+            closeCandle();
+            startCandleTimer();
+        }
+    });
+}
+
+void MockExchange::closeCandle() {
+    // Live candles follow the replayed book, so the book trades through the resting orders now and then
+    double center = book->isEmpty() ? replay.getFirstPrice() : (book->askPrice() + book->bidPrice()) / 2;
+    Candle candle = MarketReplay::candle(nextCandle++, candleOrigin, center);
+    std::string topic = "klineV2.1." + settings.symbol;
+    long timestamp = duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+
+    // The first order request after a closed candle is taken as the order the candle's signal led to
+    lastSignal = steady_clock::now();
+    signalPending = true;
+    candlesClosed++;
+
+    publish(topic, frame(fmt::format(
+                       R"({{"topic":"{}","data":[{{"start":{},"end":{},"open":{},"close":{},"high":{},"low":{},)"
+                       R"("volume":{},"turnover":0,"confirm":true,"cross_seq":{},"timestamp":{}}}],"timestamp_e6":{}}})",
+                       topic, candle.timestamp, candle.timestamp + 60, candle.open, candle.close, candle.high,
+                       candle.low, candle.volume, nextCandle, timestamp, timestamp)));
+
+    // Working orders inside the candle's range were traded through
+    for (auto it = orders.begin(); it != orders.end();) {
+        MockOrder &order = it->second;
+
+        if (order.buy ? candle.low <= order.price : candle.high >= order.price) {
+            fill(order, order.price);
+            it = orders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void MockExchange::publish(const std::string &topic, std::shared_ptr<const simdjson::padded_string> payload) {
+    for (auto &weak : sessions) {
+        if (auto session = weak.lock(); session && session->isOpen() && session->isSubscribed(topic)) {
+            session->send(payload);
+        }
+    }
+}
+
+void MockExchange::onFrameSent(const size_t &bytes) {
+    framesSent++;
+    bytesSent += bytes;
+}
+
+void MockExchange::onWebsocketMessage(WebsocketSession &session, const std::string_view &msg) {
+    simdjson::dom::element request;
+    std::string_view op;
+
+    if (websocketParser.parse(msg.data(), msg.size()).get(request) || request["op"].get(op)) {
+        session.send(frame(R"({"success":false,"ret_msg":"invalid request"})"));
+        return;
+    }
+
+    bool success = true;
+    std::string_view retMsg;
+    simdjson::dom::array args;
+    std::string echoedArgs = request["args"].get(args) ? "null" : simdjson::minify(args);
+
+    if (op == "auth") {
+        // args are the api key, the expiry in ms and the signature of "GET/realtime" followed by the expiry
+        std::vector<std::string_view> values;
+
+        for (simdjson::dom::element arg : args) {
+            std::string_view value;
+            values.push_back(arg.get(value) ? std::string_view() : value);
+        }
+
+        success = values.size() == 3 && values[0] == settings.apiKey && toLong(values[1]) > nowMs()
+                  && signer.sign("GET/realtime" + std::string(values[1])) == values[2];
+        retMsg = success ? "" : "error signature";
+
+    } else if (op == "subscribe") {
+        for (simdjson::dom::element arg : args) {
+            std::string_view topic;
+
+            if (!arg.get(topic)) {
+                session.subscribe(topic);
+
+                if (topic.rfind("orderBookL2_25.", 0) == 0) {
+                    startReplay();
+                }
+            }
+        }
+
+    } else if (op == "ping") {
+        retMsg = "pong";
+    } else {
+        success = false;
+        retMsg = "unknown op";
+    }
+
+    session.send(frame(fmt::format(R"({{"success":{},"ret_msg":"{}","conn_id":"mock","request":{{"op":"{}","args":{}}}}})",
+                                   success, retMsg, op, echoedArgs)));
+}
+
+MockExchange::RestResponse MockExchange::handleRest(const std::string &method, const std::string_view &target,
+                                                    const std::string_view &body) {
+    auto separator = target.find('?');
+    std::string route(target.substr(0, separator));
+    std::string_view query = separator == std::string_view::npos ? std::string_view() : target.substr(separator + 1);
+
+    requests[method + " " + route]++;
+    RestResponse response;
+
+    if (method == "GET" && route == serverTimeRoute) {
+        response.body = apiResponse(0, "OK", "{}");
+    } else if (method == "GET" && route == klineRoute) {
+        response = klines(parseParams(query));
+    } else if (method == "GET" && route == positionListRoute) {
+        response = handlePrivate(route, query);
+    } else if (method == "POST"
+               && (route == createOrderRoute || route == replaceOrderRoute || route == cancelOrderRoute
+                   || route == cancelAllRoute || route == tradingStopRoute)) {
+        response = handlePrivate(route, body);
+    } else {
+        response.status = 404;
+        response.body = apiResponse(10001, "route not found", "null");
+    }
+
+    if (response.status != 200 || response.body.rfind(R"({"ret_code":0,)", 0) != 0) {
+        rejectedRequests[method + " " + route]++;
+    }
+
+    return response;
+}
+
+MockExchange::RestResponse MockExchange::handlePrivate(const std::string &route, const std::string_view &request) {
+    Params params = parseParams(request);
+    RateWindow &window = rateWindows[route];
+    long now = nowMs();
+
+    if (now >= window.resetMs) {
+        window = {0, now + 1000};
+    }
+
+    RestResponse response;
+
+    if (++window.used > rateLimit) {
+        response.body = apiResponse(10006, "too many visits", "null");
+    } else if (auto rejected = checkSignature(request, params)) {
+        response = *rejected;
+    } else if (route == createOrderRoute) {
+        response = createOrder(params);
+    } else if (route == replaceOrderRoute) {
+        response = replaceOrder(params);
+    } else if (route == cancelOrderRoute) {
+        response = cancelOrder(params);
+    } else if (route == cancelAllRoute) {
+        response = cancelAllOrders();
+    } else if (route == positionListRoute) {
+        response = positionList();
+    } else {
+        response.body = apiResponse(0, "OK", "{}");  // trading-stop, the stop loss itself isn't simulated
+    }
+
+    response.rateLimitStatus = std::max(rateLimit - window.used, 0L);
+    response.rateLimitResetMs = window.resetMs;
+
+    // Private responses also carry the rate limit in the body
+    response.body.pop_back();
+    response.body += fmt::format(R"(,"rate_limit_status":{},"rate_limit_reset_ms":{},"rate_limit":{}}})",
+                                 response.rateLimitStatus, response.rateLimitResetMs, rateLimit);
+
+    return response;
+}
+
+std::optional<MockExchange::RestResponse> MockExchange::checkSignature(const std::string_view &request,
+                                                                       const Params &params) {
+    auto sign = params.find("sign");
+    auto apiKey = params.find("api_key");
+    auto timestamp = params.find("timestamp");
+    auto recvWindow = params.find("recv_window");
+    RestResponse response;
+
+    if (apiKey == params.end() || apiKey->second != settings.apiKey) {
+        response.body = apiResponse(10003, "invalid api_key", "null");
+        return response;
+    }
+
+    // Everything before the signature is signed, the fields are already in alphabetical order
+    auto signStart = request.rfind("&sign=");
+
+    if (sign == params.end() || signStart == std::string_view::npos
+        || signer.sign(request.substr(0, signStart)) != sign->second) {
+        response.body = apiResponse(10004, "error sign!", "null");
+        return response;
+    }
+
+    long sent = timestamp == params.end() ? 0 : toLong(timestamp->second);
+    long window = recvWindow == params.end() ? 5000 : toLong(recvWindow->second);
+    long now = nowMs();
+
+    if (sent > now + 1000 || now - sent >= window) {
+        response.body = apiResponse(10002, "invalid request, please check your timestamp and recv_window param",
+                                    "null");
+        return response;
+    }
+
+    return std::nullopt;
+}
+
+MockExchange::RestResponse MockExchange::createOrder(const Params &params) {
+    RestResponse response;
+
+    if (signalPending) {
+        signalPending = false;
+        signalToOrder.record(steady_clock::now() - lastSignal);
+        response.signalTime = lastSignal;
+    }
+
+    auto field = [&params](const std::string_view &key) {
+        auto it = params.find(key);
+        return it == params.end() ? std::string_view() : it->second;
+    };
+
+    MockOrder order;
+    order.id = fmt::format("mock-{:012}", nextOrderId++);
+    order.linkId = field("order_link_id");
+    order.buy = field("side") == "Buy";
+    order.market = field("order_type") == "Market";
+    order.reduceOnly = field("reduce_only") == "true";
+    order.price = toDouble(field("price"));
+    order.qty = toLong(field("qty"));
+    order.status = "Created";
+
+    if (order.qty <= 0 || (!order.market && order.price <= 0)) {
+        response.body = apiResponse(10001, "invalid order", "null");
+        return response;
+    }
+
+    response.body = apiResponse(
+        0, "OK",
+        fmt::format(R"({{"user_id":1,"order_id":"{}","symbol":"{}","side":"{}","order_type":"{}","price":{},)"
+                    R"("qty":{},"order_status":"Created","leaves_qty":{},"cum_exec_qty":0,"order_link_id":"{}"}})",
+                    order.id, settings.symbol, order.buy ? "Buy" : "Sell", order.market ? "Market" : "Limit",
+                    order.price, order.qty, order.qty, order.linkId));
+
+    // A reduce only order can at most close the position
+    if (order.reduceOnly) {
+        bool reduces = order.buy ? positionQty < 0 : positionQty > 0;
+        order.qty = reduces ? std::min(order.qty, std::abs(positionQty)) : 0;
+    }
+
+    double bestAsk = book->askPrice();
+    double bestBid = book->bidPrice();
+
+    if (order.qty == 0 || (order.market && book->isEmpty())) {
+        order.status = "Cancelled";
+        publishOrder(order);
+    } else if (order.market) {
+        fill(order, order.buy ? bestAsk : bestBid);
+    } else if (order.buy ? order.price >= bestAsk : order.price <= bestBid) {
+        // Post only orders that would take liquidity are cancelled
+        order.status = "Cancelled";
+        publishOrder(order);
+    } else {
+        order.status = "New";
+        publishOrder(order);
+        orders[order.id] = order;
+    }
+
+    return response;
+}
+
+MockExchange::RestResponse MockExchange::replaceOrder(const Params &params) {
+    RestResponse response;
+    auto id = params.find("order_id");
+    auto price = params.find("p_r_price");
+    auto it = id == params.end() ? orders.end() : orders.find(std::string(id->second));
+
+    if (it == orders.end()) {
+        response.body = apiResponse(30032, "order already filled or cancelled", "null");
+        return response;
+    }
+
+    if (price != params.end()) {
+        it->second.price = toDouble(price->second);
+    }
+
+    response.body = apiResponse(0, "OK", fmt::format(R"({{"order_id":"{}"}})", it->second.id));
+    matchWorkingOrders();
+
+    return response;
+}
+
+MockExchange::RestResponse MockExchange::cancelOrder(const Params &params) {
+    RestResponse response;
+    auto id = params.find("order_id");
+    auto it = id == params.end() ? orders.end() : orders.find(std::string(id->second));
+
+    if (it == orders.end()) {
+        response.body = apiResponse(30032, "order already filled or cancelled", "null");
+        return response;
+    }
+
+    it->second.status = "Cancelled";
+    publishOrder(it->second);
+    response.body = apiResponse(0, "OK", fmt::format(R"({{"order_id":"{}","order_status":"Cancelled"}})", it->first));
+    orders.erase(it);
+
+    return response;
+}
+
+MockExchange::RestResponse MockExchange::cancelAllOrders() {
+    for (auto &[id, order] : orders) {
+        order.status = "Cancelled";
+        publishOrder(order);
+    }
+
+    orders.clear();
+
+    RestResponse response;
+    response.body = apiResponse(0, "OK", "[]");
+    return response;
+}
+
+MockExchange::RestResponse MockExchange::positionList() {
+    RestResponse response;
+    response.body = apiResponse(
+        0, "OK",
+        fmt::format(R"({{"user_id":1,"symbol":"{}","side":"{}","size":{},"entry_price":"{:.8f}","leverage":"10"}})",
+                    settings.symbol, positionQty > 0 ? "Buy" : positionQty < 0 ? "Sell" : "None",
+                    std::abs(positionQty), entryPrice));
+
+    return response;
+}
+
+MockExchange::RestResponse MockExchange::klines(const Params &params) {
+    auto from = params.find("from");
+    long first = from == params.end() ? 0 : toLong(from->second);
+
+    // Candles up to the one currently forming, at most 200 like the exchange
+    long index = static_cast<long>(std::ceil((first - candleOrigin) / 60.0));
+    long last = std::min(index + 200, nextCandle + 1);
+    std::string result = "[";
+
+    for (; index < last; index++) {
+        Candle candle = MarketReplay::candle(index, candleOrigin, replay.getFirstPrice());
+        result += fmt::format(R"({{"symbol":"{}","interval":"1","open_time":{},"open":"{}","high":"{}","low":"{}",)"
+                              R"("close":"{}","volume":"{}","turnover":"0"}},)",
+                              settings.symbol, candle.timestamp, candle.open, candle.high, candle.low, candle.close,
+                              candle.volume);
+    }
+
+    if (result.size() > 1) {
+        result.pop_back();
+    }
+    result += "]";
+
+    RestResponse response;
+    response.body = apiResponse(0, "OK", result);
+    return response;
+}
+
+void MockExchange::matchWorkingOrders() {
+    double bestAsk = book->askPrice();
+    double bestBid = book->bidPrice();
+
+    for (auto it = orders.begin(); it != orders.end();) {
+        MockOrder &order = it->second;
+
+        if (order.buy ? bestAsk <= order.price : bestBid >= order.price) {
+            fill(order, order.price);
+            it = orders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void MockExchange::fill(MockOrder &order, const double &price) {
+    long signedQty = order.buy ? order.qty : -order.qty;
+    long newQty = positionQty + signedQty;
+
+    if (positionQty == 0 || (positionQty > 0) == (signedQty > 0)) {
+        entryPrice = (std::abs(positionQty) * entryPrice + order.qty * price) / (std::abs(positionQty) + order.qty);
+    } else if (newQty == 0) {
+        entryPrice = 0;
+    } else if ((newQty > 0) != (positionQty > 0)) {
+        entryPrice = price;  // flipped, the rest of the order opened a new position
+    }
+
+    positionQty = newQty;
+    order.filledQty = order.qty;
+    order.status = "Filled";
+    fills++;
+
+    publishOrder(order);
+    publishPosition();
+}
+
+void MockExchange::publishOrder(const MockOrder &order) {
+    publish("order", frame(fmt::format(
+                         R"({{"topic":"order","data":[{{"order_id":"{}","order_link_id":"{}","symbol":"{}",)"
+                         R"("side":"{}","order_type":"{}","price":"{}","qty":{},"time_in_force":"{}",)"
+                         R"("order_status":"{}","leaves_qty":{},"cum_exec_qty":{},"reduce_only":{}}}]}})",
+                         order.id, order.linkId, settings.symbol, order.buy ? "Buy" : "Sell",
+                         order.market ? "Market" : "Limit", order.price, order.qty,
+                         order.market ? "ImmediateOrCancel" : "PostOnly", order.status,
+                         order.qty - order.filledQty, order.filledQty, order.reduceOnly)));
+}
+
+void MockExchange::publishPosition() {
+    publish("position", frame(fmt::format(
+                            R"({{"topic":"position","action":"update","data":[{{"user_id":1,"symbol":"{}",)"
+                            R"("size":{},"side":"{}","entry_price":"{:.8f}","leverage":"10","position_seq":{}}}]}})",
+                            settings.symbol, std::abs(positionQty),
+                            positionQty > 0 ? "Buy" : positionQty < 0 ? "Sell" : "None", entryPrice,
+                            ++positionSeq)));
+}
+
+std::string MockExchange::renderReport() {
+    double elapsed = duration<double>(steady_clock::now() - started).count();
+
+    auto histogram = [](LatencyHistogram &histogram) {
+        auto snapshot = histogram.snapshot();
+        return fmt::format(R"({{"count":{},"p50_us":{:.1f},"p99_us":{:.1f},"p999_us":{:.1f},"max_us":{:.1f}}})",
+                           snapshot.total, snapshot.percentile(50) / 1e3, snapshot.percentile(99) / 1e3,
+                           snapshot.percentile(99.9) / 1e3, snapshot.max / 1e3);
+    };
+
+    auto counts = [](const std::map<std::string, uint64_t> &counts) {
+        std::string json = "{";
+
+        for (auto const &[name, count] : counts) {
+            json += fmt::format(R"("{}":{},)", name, count);
+        }
+
+        if (json.size() > 1) {
+            json.pop_back();
+        }
+        return json + "}";
+    };
+
+    return fmt::format(
+        R"({{"duration_s":{:.3f},"delay_us":{},"jitter_us":{},"replay_speed":{},"frames_sent":{},)"
+        R"("frames_per_second":{:.1f},"bytes_per_second":{:.1f},"replayed_frames":{},"candles_closed":{},)"
+        R"("fills":{},"signal_to_order":{},"signal_to_ack":{},"requests":{},"rejected_requests":{}}})",
+        elapsed, settings.delay.count(), settings.jitter.count(), settings.replaySpeed, framesSent,
+        framesSent / elapsed, bytesSent / elapsed, replayedFrames, candlesClosed, fills,
+        histogram(signalToOrder), histogram(signalToAck), counts(requests),
+        counts(rejectedRequests));
+}
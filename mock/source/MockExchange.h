@@ -0,0 +1,192 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_MOCKEXCHANGE_H
+#define BYTRA_MOCKEXCHANGE_H
+
+#include <simdjson.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../../bytra/source/HmacSigner.h"
+#include "../../bytra/source/LatencyStats.h"
+#include "../../bytra/source/MarketDataParser.h"
+#include "../../bytra/source/OrderBook.h"
+#include "MarketReplay.h"
+
+namespace net = boost::asio;       // from <boost/asio.hpp>
+namespace ssl = boost::asio::ssl;  // from <boost/asio/ssl.hpp>
+using tcp = boost::asio::ip::tcp;  // from <boost/asio/ip/tcp.hpp>
+
+/** Local stand-in for Bybit, to measure the whole trading path without touching the exchange
+ * Serves the REST routes Bybit calls over plain HTTP and a TLS websocket that replays recorded order book and
+ * kline messages and reports the orders and position of the single mock account. Market orders fill at the top
+ * of the replayed book, limit orders once the book or a closed candle trades through their price. Signed requests
+ * are checked like the exchange does.
+ *
+ * Meant for one client at a time: a subscription to the order book starts the replay over from its snapshot.
+ * Everything runs on one thread of its own.
+ * */
+class MockExchange {
+  public:
+    struct Settings {
+        unsigned short restPort = 9080;
+        unsigned short websocketPort = 9443;
+        std::chrono::microseconds delay{0};   // added to every websocket frame and REST response
+        std::chrono::microseconds jitter{0};  // uniform random extra delay, up to this much
+        double replaySpeed = 1.0;             // relative to the recording, 0 is as fast as the client reads
+        std::chrono::milliseconds candleInterval{100};
+        std::string symbol = "BTCUSD";
+        std::string apiKey;
+        std::string apiSecret;
+    };
+
+  private:
+    class WebsocketSession;
+    class RestSession;
+
+    struct MockOrder {
+        std::string id;
+        std::string linkId;
+        bool buy = true;
+        bool market = false;
+        bool reduceOnly = false;
+        double price = 0;
+        long qty = 0;
+        long filledQty = 0;
+        std::string status;
+    };
+
+    struct RestResponse {
+        std::string body;
+        unsigned status = 200;
+        long rateLimitStatus = -1;  // -1 for routes without a rate limit
+        long rateLimitResetMs = 0;
+        std::optional<std::chrono::steady_clock::time_point> signalTime;  // set for the first order after a signal
+    };
+
+    struct RateWindow {
+        long used = 0;
+        long resetMs = 0;
+    };
+
+    using Params = std::map<std::string_view, std::string_view>;
+
+    static constexpr long rateLimit = 100;      // requests per route per second
+    static constexpr size_t maxBacklog = 256;  // frames waiting to be written before the replay holds back
+
+    Settings settings;
+    MarketReplay replay;
+    HmacSigner signer;
+    net::io_context ioc;
+    ssl::context sslContext{ssl::context::tlsv12_server};
+    tcp::acceptor restAcceptor;
+    tcp::acceptor websocketAcceptor;
+    net::steady_timer replayTimer;
+    net::steady_timer candleTimer;
+    std::vector<std::weak_ptr<WebsocketSession>> sessions;
+    simdjson::dom::parser websocketParser;
+    std::thread thread;
+
+    size_t replayPosition = 0;
+    unsigned long replayGeneration = 0;
+    std::chrono::steady_clock::time_point replayStart;
+    std::shared_ptr<OrderBook> book;
+    std::unique_ptr<MarketDataParser> bookParser;
+    long candleOrigin = 0;  // open time of candle 0, in seconds
+    long nextCandle = 0;
+
+    std::map<std::string, MockOrder> orders;  // working orders by order id
+    unsigned long nextOrderId = 1;
+    long positionQty = 0;
+    double entryPrice = 0;
+    long positionSeq = 0;
+    std::map<std::string, RateWindow> rateWindows;
+
+    std::chrono::steady_clock::time_point started;
+    std::chrono::steady_clock::time_point lastSignal;
+    bool signalPending = false;
+    LatencyHistogram signalToOrder;
+    LatencyHistogram signalToAck;
+    uint64_t framesSent = 0;
+    uint64_t bytesSent = 0;
+    uint64_t replayedFrames = 0;
+    uint64_t candlesClosed = 0;
+    uint64_t fills = 0;
+    std::map<std::string, uint64_t> requests;
+    std::map<std::string, uint64_t> rejectedRequests;
+
+    void acceptWebsocket();
+
+    void acceptRest();
+
+    void startReplay();
+
+    void scheduleReplay();
+
+    void replayNext();
+
+    void startCandleTimer();
+
+    void closeCandle();
+
+    void publish(const std::string &topic, std::shared_ptr<const simdjson::padded_string> payload);
+
+    void onWebsocketMessage(WebsocketSession &session, const std::string_view &msg);
+
+    void onFrameSent(const size_t &bytes);
+
+    RestResponse handleRest(const std::string &method, const std::string_view &target, const std::string_view &body);
+
+    RestResponse handlePrivate(const std::string &route, const std::string_view &request);
+
+    std::optional<RestResponse> checkSignature(const std::string_view &request, const Params &params);
+
+    RestResponse createOrder(const Params &params);
+
+    RestResponse replaceOrder(const Params &params);
+
+    RestResponse cancelOrder(const Params &params);
+
+    RestResponse cancelAllOrders();
+
+    RestResponse positionList();
+
+    RestResponse klines(const Params &params);
+
+    void matchWorkingOrders();
+
+    void fill(MockOrder &order, const double &price);
+
+    void publishOrder(const MockOrder &order);
+
+    void publishPosition();
+
+    std::string renderReport();
+
+  public:
+    MockExchange(Settings settings, const std::string &fixturesDir);
+
+    ~MockExchange();
+
+    MockExchange(const MockExchange &) = delete;
+
+    MockExchange &operator=(const MockExchange &) = delete;
+
+    // Latencies, message throughput and request counts since the start, as JSON
+    std::string report();
+};
+
+#endif  // BYTRA_MOCKEXCHANGE_H
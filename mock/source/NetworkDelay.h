@@ -0,0 +1,38 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#ifndef BYTRA_NETWORKDELAY_H
+#define BYTRA_NETWORKDELAY_H
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+/** Injected one way delay of a connection, a fixed part plus a uniformly distributed jitter
+ * Like on a real connection, later messages never overtake earlier ones: a message is delivered no earlier than
+ * the one before it.
+ * */
+class NetworkDelay {
+  private:
+    std::chrono::microseconds delay;
+    std::uniform_int_distribution<long> jitter;
+    std::mt19937_64 rng;
+    std::chrono::steady_clock::time_point lastDelivery;
+
+  public:
+    NetworkDelay(const std::chrono::microseconds &delay, const std::chrono::microseconds &jitter,
+                 const unsigned long &seed = 42)
+        : delay(delay), jitter(0, jitter.count()), rng(seed) {}
+
+    // Time at which a message sent now arrives
+    std::chrono::steady_clock::time_point deliveryTime() {
+        auto delivery = std::chrono::steady_clock::now() + delay + std::chrono::microseconds(jitter(rng));
+        lastDelivery = std::max(lastDelivery, delivery);
+        return lastDelivery;
+    }
+
+    [[nodiscard]] bool isZero() const { return delay.count() == 0 && jitter.max() == 0; }
+};
+
+#endif  // BYTRA_NETWORKDELAY_H
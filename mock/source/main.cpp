@@ -0,0 +1,76 @@
+//
+// Created by Arne Wouters on 19/10/2026.
+//
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <chrono>
+#include <cli/CLI11.hpp>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <toml++/toml.hpp>
+
+#include "MockExchange.h"
+
+namespace {
+    std::atomic<bool> stopping{false};
+
+    void signal_callback_handler(int) { stopping = true; }
+}  // namespace
+
+int main(int argc, char **argv) {
+    CLI::App app("BYTRA mock exchange");
+    std::string configuration = "data/configuration.toml";
+    app.add_option("-c,--config", configuration, "Configuration file with the [bybit-mock] and [mock] tables");
+    long durationS = 0;
+    app.add_option("--duration", durationS, "Seconds to run before writing the report, 0 runs until interrupted");
+    std::string reportFile = "mock_report.json";
+    app.add_option("-r,--report", reportFile, "File the JSON report is written to");
+    long delayUs = -1;
+    app.add_option("--delay-us", delayUs, "Overrides mock.delayUs");
+    long jitterUs = -1;
+    app.add_option("--jitter-us", jitterUs, "Overrides mock.jitterUs");
+    double replaySpeed = -1;
+    app.add_option("--replay-speed", replaySpeed, "Overrides mock.replaySpeed");
+
+    CLI11_PARSE(app, argc, argv)
+
+    toml::table tbl;
+    try {
+        tbl = toml::parse_file(configuration);
+    } catch (const toml::parse_error &err) {
+        std::cerr << "Parsing failed:\n" << err << std::endl;
+        return 1;
+    }
+
+    MockExchange::Settings settings;
+    settings.restPort = static_cast<unsigned short>(tbl["mock"]["restPort"].value_or(9080));
+    settings.websocketPort = static_cast<unsigned short>(tbl["mock"]["websocketPort"].value_or(9443));
+    settings.delay = std::chrono::microseconds(delayUs >= 0 ? delayUs : tbl["mock"]["delayUs"].value_or(0));
+    settings.jitter = std::chrono::microseconds(jitterUs >= 0 ? jitterUs : tbl["mock"]["jitterUs"].value_or(0));
+    settings.replaySpeed = replaySpeed >= 0 ? replaySpeed : tbl["mock"]["replaySpeed"].value_or(1.0);
+    settings.candleInterval = std::chrono::milliseconds(tbl["mock"]["candleIntervalMs"].value_or(100));
+    settings.apiKey = tbl["bybit-mock"]["apiKey"].value_or(std::string());
+    settings.apiSecret = tbl["bybit-mock"]["apiSecret"].value_or(std::string());
+
+    signal(SIGINT, signal_callback_handler);
+
+    MockExchange exchange(settings, BYTRA_FIXTURES_DIR);
+    std::cout << "Mock exchange running, start Bytra with --mock. Ctrl+C writes the report." << std::endl;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(durationS);
+
+    while (!stopping && (durationS == 0 || std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    std::string report = exchange.report();
+    std::ofstream(reportFile) << report << std::endl;
+    std::cout << report << std::endl << "Report written to " << reportFile << std::endl;
+
+    return 0;
+}
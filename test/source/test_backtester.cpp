@@ -0,0 +1,135 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#include "../backtest/source/Backtester.cpp"
+#include "../backtest/source/CandleSeries.cpp"
+
+namespace {
+    // Goes long below 95 and exits above 105, on every candle
+    class LevelStrategy : public Strategy {
+      public:
+        explicit LevelStrategy(const std::string &orderType) {
+            name = "Levels";
+            timeframes = {{"1", 1}};
+            symbol = "BTCUSD";
+            qty = 100;
+            this->orderType = orderType;
+            slippage = 1.0;
+            stopLossPercentage = 0.1;
+        }
+
+        bool checkLongEntry(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles) override {
+            return false;
+        }
+
+        bool checkShortEntry(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles) override {
+            return false;
+        }
+
+        bool checkExit(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
+                       std::shared_ptr<Position> position) override {
+            return false;
+        }
+
+        bool updateTriggerLevels(std::map<TimeFrame, std::vector<std::shared_ptr<Candle>>> &candles,
+                                 TriggerLevels &levels) override {
+            levels.longEntry = {PriceTrigger::Below, 95};
+            levels.longExit = {PriceTrigger::Above, 105};
+            return true;
+        }
+    };
+
+    // open, high, low, close, one minute apart
+    CandleSeries makeSeries(const std::vector<std::array<double, 4>> &prices) {
+        CandleSeries series;
+        long timestamp = 1603101600;
+
+        for (auto &[open, high, low, close] : prices) {
+            series.push_back({open, high, low, close, 1000, timestamp});
+            timestamp += 60;
+        }
+
+        return series;
+    }
+
+    Backtester::Settings testSettings() {
+        Backtester::Settings settings;
+        settings.makerFee = -0.00025;
+        settings.takerFee = 0.00075;
+        settings.warmup = 0;
+        settings.recordTrades = true;
+        return settings;
+    }
+}  // namespace
+
+TEST_CASE("CandleSeries reads CSV candles") {
+    std::string path = "test_candles.csv";
+    std::ofstream(path) << "timestamp,open,high,low,close,volume\n"
+                        << "1603101600,11700.5,11710,11690,11705.5,12000\n"
+                        << "1603101660,11705.5,11720,11700,11715,8000\r\n";
+
+    CandleSeries series = CandleSeries::loadCsv(path);
+    REQUIRE(series.size() == 2);
+    CHECK(series.interval() == 60);
+    CHECK(series.at(1).close == 11715);
+    CHECK(series.open[0] == 11700.5);
+
+    std::ofstream(path) << "1603101600,11700.5,11710,11690\n";
+    CHECK_THROWS_AS(CandleSeries::loadCsv(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Backtester fills market orders with slippage and fees") {
+    auto series = makeSeries({{100, 101, 99, 100}, {100, 100, 93, 94}, {94, 101, 94, 100}, {100, 107, 100, 106}});
+
+    auto result = Backtester(std::make_shared<LevelStrategy>("Market"), testSettings()).run(series);
+
+    REQUIRE(result.trades == 1);
+    auto &trade = result.tradeLog[0];
+    CHECK(trade.entryPrice == 95);
+    CHECK(trade.exitPrice == 105);
+
+    double fees = 0.00075 * (100 / 95.0 + 100 / 105.0);
+    CHECK(result.fees == doctest::Approx(fees));
+    CHECK(result.pnl() == doctest::Approx(100 * (1 / 95.0 - 1 / 105.0) - fees));
+    CHECK(result.wins == 1);
+}
+
+TEST_CASE("Backtester fills limit orders once a candle trades through them") {
+    auto series = makeSeries({{100, 101, 99, 100},
+                              {100, 100, 93, 94},
+                              {94, 95, 93.5, 94.5},  // the buy at 94 fills
+                              {94.5, 107, 94, 106},
+                              {106, 106, 104, 104.5}});  // the sell at 106 never fills and leaves its interval
+
+    auto result = Backtester(std::make_shared<LevelStrategy>("Limit"), testSettings()).run(series);
+
+    REQUIRE(result.trades == 1);
+    CHECK(result.tradeLog[0].entryPrice == 94);
+    CHECK(result.tradeLog[0].exitPrice == 103.5);  // market order at the close, the slippage against us
+    CHECK(result.fees == doctest::Approx(-0.00025 * 100 / 94.0 + 0.00075 * 100 / 103.5));
+}
+
+TEST_CASE("Backtester stop loss and drawdown") {
+    auto series = makeSeries({{100, 101, 99, 100}, {100, 100, 93, 94}, {90, 90, 80, 82}});
+
+    auto result = Backtester(std::make_shared<LevelStrategy>("Market"), testSettings()).run(series);
+
+    REQUIRE(result.trades == 2);
+    CHECK(result.stopLosses == 1);
+    CHECK(result.tradeLog[0].stopLoss);
+    CHECK(result.tradeLog[0].exitPrice == doctest::Approx(84.5));  // the stop at 85.5, less the slippage
+    CHECK(result.tradeLog[1].exitPrice == 81);                      // closed after the last candle
+    CHECK(result.maxDrawdown > 0);
+    CHECK(result.pnl() < 0);
+
+    auto hourly = makeSeries({{100, 101, 99, 100}, {100, 100, 93, 94}});
+    hourly.timestamp[1] = hourly.timestamp[0] + 3600;
+    CHECK_THROWS_AS(Backtester(std::make_shared<LevelStrategy>("Market"), testSettings()).run(hourly),
+                    std::invalid_argument);
+}
@@ -0,0 +1,28 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+
+#include "../bytra/source/ServerTime.h"
+
+using namespace std::chrono;
+
+TEST_CASE("Server time parsing") {
+    CHECK(parseServerTime("1577444332.192859") == microseconds(1577444332192859));
+    CHECK(parseServerTime("1577444332.5") == microseconds(1577444332500000));
+    CHECK(parseServerTime("1577444332") == microseconds(1577444332000000));
+    CHECK(!parseServerTime("1577444332,5"));
+    CHECK(!parseServerTime(""));
+}
+
+TEST_CASE("ClockFilter keeps the sample with the shortest round trip") {
+    ClockFilter filter(3);
+    filter.add({microseconds(500), microseconds(4000)});
+    filter.add({microseconds(200), microseconds(1000)});
+    filter.add({microseconds(900), microseconds(9000)});
+    CHECK(filter.best().offset == microseconds(200));
+
+    // The oldest samples are replaced first
+    filter.add({microseconds(300), microseconds(3000)});
+    filter.add({microseconds(400), microseconds(2000)});
+    CHECK(filter.best().offset == microseconds(400));
+}
@@ -0,0 +1,20 @@
+#include <doctest/doctest.h>
+
+#include <string>
+
+#include "../bytra/source/HmacSigner.cpp"
+
+TEST_CASE("HmacSigner") {
+    // RFC 4231 test cases 2 and 6
+    HmacSigner signer("Jefe");
+    CHECK(signer.sign("what do ya want for nothing?")
+          == "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+
+    HmacSigner longKeySigner(std::string(131, '\xaa'));
+    CHECK(longKeySigner.sign("Test Using Larger Than Block-Size Key - Hash Key First")
+          == "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+
+    char out[HmacSigner::signatureLength];
+    signer.sign("what do ya want for nothing?", out);
+    CHECK(std::string(out, HmacSigner::signatureLength) == signer.sign("what do ya want for nothing?"));
+}
@@ -0,0 +1,39 @@
+#include <doctest/doctest.h>
+
+#include <cmath>
+
+#include "../bytra/source/strategies/Indicators.h"
+
+TEST_CASE("WilderRsi trigger prices") {
+    WilderRsi rsi(10);
+
+    for (int i = 0; i < 100; i++) {
+        rsi.update(10000 + 50 * std::sin(i * 0.3) + i);
+    }
+
+    REQUIRE(rsi.ready());
+
+    for (double target : {30.0, 50.0, 70.0}) {
+        WilderRsi next = rsi;
+        next.update(rsi.closeFor(target));
+        CHECK(next.value() == doctest::Approx(target));
+    }
+
+    CHECK(rsi.closeFor(30) < rsi.closeFor(50));
+    CHECK(rsi.closeFor(50) < rsi.closeFor(70));
+}
+
+TEST_CASE("ExponentialMovingAverage") {
+    ExponentialMovingAverage ema(3);
+
+    for (double close : {1.0, 2.0, 3.0}) {
+        ema.update(close);
+    }
+
+    REQUIRE(ema.ready());
+    CHECK(ema.value() == doctest::Approx(2.0));
+
+    ema.update(4.0);
+    CHECK(ema.value() == doctest::Approx(3.0));
+    CHECK(ema.next(6.0) == doctest::Approx(4.5));
+}
@@ -0,0 +1,36 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+
+#include "../bytra/source/LatencyStats.cpp"
+
+using namespace std::chrono;
+
+TEST_CASE("LatencyHistogram buckets") {
+    for (uint64_t value : {uint64_t(0), uint64_t(127), uint64_t(128), uint64_t(1000), uint64_t(123456789)}) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+
+        CHECK(index < LatencyHistogram::bucketCount);
+        CHECK(LatencyHistogram::bucketValue(index) >= value);
+        CHECK(LatencyHistogram::bucketValue(index) - value <= value / 64);
+    }
+
+    CHECK(LatencyHistogram::bucketIndex(LatencyHistogram::maxValue + 1) == LatencyHistogram::bucketCount - 1);
+}
+
+TEST_CASE("LatencyHistogram percentiles") {
+    LatencyHistogram histogram;
+
+    for (int i = 1; i <= 10000; i++) {
+        histogram.record(microseconds(i));
+    }
+
+    auto snapshot = histogram.snapshot(true);
+    CHECK(snapshot.total == 10000);
+    CHECK(snapshot.max == 10000000);
+    CHECK(snapshot.percentile(50) == doctest::Approx(5000000).epsilon(0.01));
+    CHECK(snapshot.percentile(99) == doctest::Approx(9900000).epsilon(0.01));
+    CHECK(snapshot.percentile(100) == 10000000);
+
+    CHECK(histogram.snapshot().total == 0);
+}
@@ -0,0 +1,99 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+
+#include "../bytra/source/LimitOrderChaser.cpp"
+
+using namespace std::chrono;
+
+namespace {
+    LimitOrderChaser::Settings chaserSettings() {
+        LimitOrderChaser::Settings settings;
+        settings.minAmendInterval = milliseconds(100);
+        settings.tickSize = 0.5;
+        settings.hysteresisTicks = 2;
+        settings.rateLimitReserve = 5;
+        return settings;
+    }
+}  // namespace
+
+TEST_CASE("LimitOrderChaser price interval") {
+    Order ord(100.0, 10, 2.0);
+
+    CHECK_FALSE(LimitOrderChaser::leftInterval(ord, 100.0));
+    CHECK_FALSE(LimitOrderChaser::leftInterval(ord, 98.0));
+    CHECK_FALSE(LimitOrderChaser::leftInterval(ord, 102.0));
+    CHECK(LimitOrderChaser::leftInterval(ord, 97.5));
+    CHECK(LimitOrderChaser::leftInterval(ord, 102.5));
+}
+
+TEST_CASE("LimitOrderChaser hysteresis") {
+    LimitOrderChaser chaser(chaserSettings());
+    Order ord(100.0, 10, 5.0);
+    auto now = steady_clock::now();
+
+    // Less than two ticks away the order stays
+    CHECK_FALSE(chaser.chase(ord, 100.5, now).has_value());
+    CHECK_FALSE(chaser.chase(ord, 100.0, now).has_value());
+
+    auto price = chaser.chase(ord, 101.0, now);
+    REQUIRE(price.has_value());
+    CHECK(*price == 101.0);
+}
+
+TEST_CASE("LimitOrderChaser amend throttling") {
+    LimitOrderChaser chaser(chaserSettings());
+    Order ord(100.0, 10, 5.0);
+    auto now = steady_clock::now();
+
+    REQUIRE(chaser.chase(ord, 101.0, now).has_value());
+    ord.price = 101.0;
+    CHECK(chaser.nextAmendTime() == now + milliseconds(100));
+
+    // Amends within the interval are held back, the latest target is kept
+    CHECK_FALSE(chaser.chase(ord, 102.0, now + milliseconds(10)).has_value());
+    CHECK(chaser.hasPendingAmend());
+    CHECK_FALSE(chaser.chase(ord, 103.0, now + milliseconds(20)).has_value());
+    CHECK(chaser.hasPendingAmend());
+
+    // Back within the hysteresis nothing is left to send
+    CHECK_FALSE(chaser.chase(ord, 101.0, now + milliseconds(30)).has_value());
+    CHECK_FALSE(chaser.hasPendingAmend());
+
+    CHECK_FALSE(chaser.chase(ord, 103.0, now + milliseconds(40)).has_value());
+    auto price = chaser.chase(ord, 103.0, chaser.nextAmendTime());
+    REQUIRE(price.has_value());
+    CHECK(*price == 103.0);
+    CHECK_FALSE(chaser.hasPendingAmend());
+}
+
+TEST_CASE("LimitOrderChaser rate limit reserve") {
+    LimitOrderChaser chaser(chaserSettings());
+    Order ord(100.0, 10, 5.0);
+    auto now = steady_clock::now();
+    auto reset = now + seconds(5);
+
+    // At the reserve amends wait for the rate limit window to reset
+    chaser.onRateLimit(5, reset);
+    CHECK(chaser.nextAmendTime() == reset);
+    CHECK_FALSE(chaser.chase(ord, 101.0, now).has_value());
+    CHECK(chaser.hasPendingAmend());
+    CHECK(chaser.chase(ord, 101.0, reset).has_value());
+
+    // Above the reserve only the amend interval counts
+    chaser.onRateLimit(50, reset);
+    CHECK(chaser.nextAmendTime() == reset + milliseconds(100));
+}
+
+TEST_CASE("LimitOrderChaser reset") {
+    LimitOrderChaser chaser(chaserSettings());
+    Order ord(100.0, 10, 5.0);
+    auto now = steady_clock::now();
+
+    REQUIRE(chaser.chase(ord, 101.0, now).has_value());
+    CHECK_FALSE(chaser.chase(ord, 102.0, now + milliseconds(10)).has_value());
+    REQUIRE(chaser.hasPendingAmend());
+
+    chaser.reset();
+    CHECK_FALSE(chaser.hasPendingAmend());
+}
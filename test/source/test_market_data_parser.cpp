@@ -0,0 +1,89 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+
+#include "../bytra/source/MarketDataParser.cpp"
+
+namespace {
+    bool parse(MarketDataParser &parser, const std::string &msg) {
+        simdjson::padded_string padded(msg);
+        return parser.parse(reinterpret_cast<const uint8_t *>(padded.data()), padded.size());
+    }
+}  // namespace
+
+TEST_CASE("MarketDataParser order book messages") {
+    auto orderBook = std::make_shared<OrderBook>();
+    std::vector<std::string> resyncs;
+    MarketDataParser parser(
+        orderBook, [](const std::string_view &, const Candle &) {},
+        [&resyncs](const std::string_view &error) { resyncs.emplace_back(error); });
+    parser.addTopic("orderBookL2_25.BTCUSD");
+
+    CHECK(parse(parser, R"({"topic":"orderBookL2_25.BTCUSD","type":"snapshot","data":[)"
+                        R"({"price":"10420.0","symbol":"BTCUSD","id":104200000,"side":"Buy","size":100},)"
+                        R"({"price":"10420.5","symbol":"BTCUSD","id":104205000,"side":"Sell","size":200},)"
+                        R"({"price":"10421.0","symbol":"BTCUSD","id":104210000,"side":"Sell","size":300}]})"));
+    CHECK(orderBook->bidPrice() == 10420.0);
+    CHECK(orderBook->askPrice() == 10420.5);
+
+    // Messages of other topics are left to the DOM parser
+    CHECK_FALSE(parse(parser, R"({"topic":"orderBookL2_25.ETHUSD","type":"delta","data":{}})"));
+    CHECK_FALSE(parse(parser, R"({"success":true,"ret_msg":"","request":{"op":"ping","args":null}})"));
+
+    // Without the type in front of the data the message is left to the DOM parser, nothing is applied
+    CHECK_FALSE(parse(parser, R"({"topic":"orderBookL2_25.BTCUSD","data":{"delete":[)"
+                              R"({"price":"10420.5","symbol":"BTCUSD","id":104205000,"side":"Sell"}],)"
+                              R"("update":[],"insert":[]},"type":"delta"})"));
+    CHECK(orderBook->askPrice() == 10420.5);
+    CHECK(resyncs.empty());
+
+    CHECK(parse(parser, R"({"topic":"orderBookL2_25.BTCUSD","type":"delta","data":{"delete":[)"
+                        R"({"price":"10420.5","symbol":"BTCUSD","id":104205000,"side":"Sell"}],)"
+                        R"("update":[],"insert":[]}})"));
+    CHECK(orderBook->askPrice() == 10421.0);
+    CHECK(resyncs.empty());
+
+    // An invalid entry halfway through a delta leaves the book partly applied, it has to be resubscribed
+    CHECK(parse(parser, R"({"topic":"orderBookL2_25.BTCUSD","type":"delta","data":{"delete":[)"
+                        R"({"price":"10420.0","symbol":"BTCUSD","id":104200000,"side":"Buy"}],)"
+                        R"("update":[],"insert":[{"price":"10419.5","symbol":"BTCUSD","id":"104195000",)"
+                        R"("side":"Buy","size":50}]}})"));
+    CHECK(resyncs.size() == 1);
+
+    // The snapshot of the new subscription replaces the book
+    CHECK(parse(parser, R"({"topic":"orderBookL2_25.BTCUSD","type":"snapshot","data":[)"
+                        R"({"price":"10419.5","symbol":"BTCUSD","id":104195000,"side":"Buy","size":50},)"
+                        R"({"price":"10421.0","symbol":"BTCUSD","id":104210000,"side":"Sell","size":300}]})"));
+    CHECK(orderBook->bidPrice() == 10419.5);
+    CHECK(orderBook->askPrice() == 10421.0);
+    CHECK(resyncs.size() == 1);
+}
+
+TEST_CASE("MarketDataParser kline messages") {
+    auto orderBook = std::make_shared<OrderBook>();
+    std::vector<std::string> intervals;
+    std::vector<Candle> candles;
+    MarketDataParser parser(
+        orderBook,
+        [&](const std::string_view &interval, const Candle &candle) {
+            intervals.emplace_back(interval);
+            candles.push_back(candle);
+        },
+        [](const std::string_view &) {});
+    parser.addTopic("klineV2.15.BTCUSD");
+
+    // Klines have no type, only confirmed candles are handed on
+    CHECK(parse(parser, R"({"topic":"klineV2.15.BTCUSD","data":[)"
+                        R"({"start":1603101600,"end":1603102500,"open":10420,"close":10425.5,"high":10430,)"
+                        R"("low":10410,"volume":1200,"turnover":0.115,"confirm":true,"cross_seq":1,)"
+                        R"("timestamp":1603102500000000},)"
+                        R"({"start":1603102500,"end":1603103400,"open":10425.5,"close":10426,"high":10426,)"
+                        R"("low":10425,"volume":10,"turnover":0.001,"confirm":false,"cross_seq":2,)"
+                        R"("timestamp":1603102501000000}],"timestamp_e6":1603102501000000})"));
+    REQUIRE(candles.size() == 1);
+    CHECK(intervals[0] == "15");
+    CHECK(candles[0].timestamp == 1603101600);
+    CHECK(candles[0].close == 10425.5);
+    CHECK(candles[0].volume == 1200);
+}
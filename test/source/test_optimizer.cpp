@@ -0,0 +1,60 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "../backtest/source/Optimizer.cpp"
+#include "../backtest/source/WorkStealingPool.cpp"
+#include "../bytra/source/strategies/Ema.cpp"
+
+TEST_CASE("WorkStealingPool runs every task") {
+    WorkStealingPool pool(4);
+    std::atomic<int> count{0};
+
+    for (int i = 0; i < 100; i++) {
+        pool.submit([&pool, &count] {
+            // Tasks submitted by a worker go to its own queue, the others steal them
+            pool.submit([&count] { count++; });
+            count++;
+        });
+    }
+    pool.wait();
+    CHECK(count == 200);
+
+    pool.submit([] { throw std::runtime_error("failed"); });
+    CHECK_THROWS_AS(pool.wait(), std::runtime_error);
+    pool.wait();
+}
+
+TEST_CASE("Strategy parameters") {
+    auto &factories = strategyFactories();
+
+    auto ema = factories.at("ema")({{"stopLossPercentage", 0.05}});
+    CHECK(ema->getStopLossPercentage() == 0.05);
+    CHECK_THROWS_AS(factories.at("ema")({{"fastPeriod", 60}}), std::invalid_argument);
+    CHECK_THROWS_AS(factories.at("rsi")({{"lenght", 14}}), std::invalid_argument);
+}
+
+TEST_CASE("Optimizer candidates") {
+    CandleSeries series;
+    Optimizer::Settings settings;
+    settings.threads = 1;
+
+    std::vector<ParameterRange> ranges = {{"fastPeriod", 10, 40, 10}, {"slowPeriod", 30, 50, 10}};
+    Optimizer grid(series, strategyFactories().at("ema"), ranges, settings);
+    auto candidates = grid.candidates();
+
+    // 4 x 3 combinations, those with the fast period not below the slow one are left out
+    CHECK(candidates.size() == 9);
+    CHECK(candidates.front().at("fastPeriod") == 10);
+    CHECK(candidates.front().at("slowPeriod") == 30);
+    CHECK(candidates.back().at("fastPeriod") == 40);
+    CHECK(candidates.back().at("slowPeriod") == 50);
+
+    settings.randomSamples = 5;
+    Optimizer random(series, strategyFactories().at("ema"), ranges, settings);
+    CHECK(random.candidates().size() <= 5);
+    CHECK(random.candidates() == random.candidates());
+
+    CHECK_THROWS_AS(grid.walkForward(candidates, 1000, 500), std::invalid_argument);
+}
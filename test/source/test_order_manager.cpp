@@ -0,0 +1,97 @@
+#include <doctest/doctest.h>
+
+#include <string>
+
+#include "../bytra/source/AsyncLogger.cpp"
+#include "../bytra/source/OrderManager.cpp"
+
+TEST_CASE("OrderManager transitions") {
+    CHECK(OrderManager::canTransition(OrderState::PendingNew, OrderState::New));
+    CHECK(OrderManager::canTransition(OrderState::PendingNew, OrderState::Filled));
+    CHECK(OrderManager::canTransition(OrderState::PendingNew, OrderState::Rejected));
+    CHECK(OrderManager::canTransition(OrderState::New, OrderState::PartiallyFilled));
+    CHECK(OrderManager::canTransition(OrderState::PartiallyFilled, OrderState::Filled));
+    CHECK(OrderManager::canTransition(OrderState::New, OrderState::Cancelled));
+
+    CHECK_FALSE(OrderManager::canTransition(OrderState::New, OrderState::PendingNew));
+    CHECK_FALSE(OrderManager::canTransition(OrderState::PartiallyFilled, OrderState::New));
+    CHECK_FALSE(OrderManager::canTransition(OrderState::New, OrderState::Rejected));
+
+    for (auto finished : {OrderState::Filled, OrderState::Cancelled, OrderState::Rejected}) {
+        for (auto to : {OrderState::PendingNew, OrderState::New, OrderState::PartiallyFilled, OrderState::Filled,
+                        OrderState::Cancelled, OrderState::Rejected}) {
+            CHECK_FALSE(OrderManager::canTransition(finished, to));
+        }
+    }
+}
+
+TEST_CASE("OrderManager lifecycle") {
+    OrderManager manager("bytra-");
+    Order ord = manager.add(Order(100.0, 10, 0.0));
+
+    CHECK(ord.linkId == "bytra-1");
+    CHECK(manager.add(Order(100.0, 10, 0.0)).linkId == "bytra-2");
+    CHECK(manager.workingOrders() == 2);
+
+    manager.acknowledge(ord.linkId, "abc");
+    const ManagedOrder *managed = manager.onExecutionReport(ord.linkId, "PartiallyFilled", 4);
+    REQUIRE(managed != nullptr);
+    CHECK(managed->state == OrderState::PartiallyFilled);
+    CHECK(managed->order.id == "abc");
+    CHECK(managed->filledQty == 4);
+
+    managed = manager.onExecutionReport(ord.linkId, "Filled", 10);
+    CHECK(managed->state == OrderState::Filled);
+    CHECK(managed->isFinished());
+    CHECK(manager.workingOrders() == 1);
+
+    // Orders of another session or placed by hand are not tracked
+    CHECK(manager.onExecutionReport("other-1", "New", 0) == nullptr);
+    CHECK(manager.onExecutionReport("", "New", 0) == nullptr);
+    CHECK(manager.onExecutionReport("bytra-1x", "New", 0) == nullptr);
+}
+
+TEST_CASE("OrderManager out of order and duplicate reports") {
+    OrderManager manager("bytra-");
+    Order ord = manager.add(Order(100.0, 10, 0.0));
+
+    // Filled before New, the late New must not bring the order back to life
+    CHECK(manager.onExecutionReport(ord.linkId, "Filled", 10)->state == OrderState::Filled);
+    CHECK(manager.onExecutionReport(ord.linkId, "New", 0)->state == OrderState::Filled);
+    manager.acknowledge(ord.linkId, "abc");
+    CHECK(manager.onExecutionReport(ord.linkId, "PartiallyFilled", 4)->state == OrderState::Filled);
+
+    // A stale report doesn't lower the filled quantity
+    CHECK(manager.onExecutionReport(ord.linkId, "Filled", 10)->filledQty == 10);
+    CHECK(manager.workingOrders() == 0);
+
+    Order second = manager.add(Order(100.0, 10, 0.0));
+    manager.onExecutionReport(second.linkId, "PartiallyFilled", 3);
+    CHECK(manager.onExecutionReport(second.linkId, "PartiallyFilled", 3)->state == OrderState::PartiallyFilled);
+    CHECK(manager.onExecutionReport(second.linkId, "New", 0)->state == OrderState::PartiallyFilled);
+    CHECK(manager.onExecutionReport(second.linkId, "Created", 0)->state == OrderState::PartiallyFilled);
+}
+
+TEST_CASE("OrderManager reject and remove") {
+    OrderManager manager("bytra-");
+    Order ord = manager.add(Order(100.0, 10, 0.0));
+
+    manager.reject(ord.linkId);
+    const ManagedOrder *managed = manager.onExecutionReport(ord.linkId, "New", 0);
+    REQUIRE(managed != nullptr);
+    CHECK(managed->state == OrderState::Rejected);
+    CHECK(manager.workingOrders() == 0);
+
+    manager.remove(ord.linkId);
+    CHECK(manager.onExecutionReport(ord.linkId, "New", 0) == nullptr);
+
+    // An acknowledged order can't be rejected anymore
+    Order second = manager.add(Order(100.0, 10, 0.0));
+    manager.acknowledge(second.linkId, "def");
+    manager.reject(second.linkId);
+    CHECK(manager.onExecutionReport(second.linkId, "New", 0)->state == OrderState::New);
+
+    manager.clear();
+    CHECK(manager.workingOrders() == 0);
+    CHECK(manager.onExecutionReport(second.linkId, "New", 0) == nullptr);
+}
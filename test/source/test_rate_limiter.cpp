@@ -0,0 +1,100 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <string>
+
+#include "../bytra/source/RateLimiter.cpp"
+
+using namespace std::chrono;
+
+namespace {
+    cpr::Header rateLimitHeader(const long &limit, const long &remaining, const system_clock::time_point &reset) {
+        return cpr::Header{{"X-Bapi-Limit", std::to_string(limit)},
+                           {"X-Bapi-Limit-Status", std::to_string(remaining)},
+                           {"X-Bapi-Limit-Reset-Timestamp",
+                            std::to_string(duration_cast<milliseconds>(reset.time_since_epoch()).count())}};
+    }
+}  // namespace
+
+TEST_CASE("RateLimiter refuses requests until the window resets") {
+    auto now = system_clock::time_point(milliseconds(1603101600000));
+    RateLimiter limiter([&now] { return now; });
+    const std::string endpoint = "/v2/private/order/create";
+
+    // Not limited before the first response
+    for (int i = 0; i < 100; i++) {
+        CHECK(limiter.tryAcquire(endpoint, RequestPriority::Backfill));
+    }
+
+    limiter.update(endpoint, rateLimitHeader(10, 2, now + seconds(1)));
+
+    // Orders keep one request of the ten aside, critical requests can use the last one
+    CHECK(limiter.tryAcquire(endpoint, RequestPriority::Order));
+    CHECK_FALSE(limiter.tryAcquire(endpoint, RequestPriority::Order));
+    CHECK_FALSE(limiter.tryAcquire(endpoint, RequestPriority::Amend));
+    CHECK(limiter.tryAcquire(endpoint, RequestPriority::Critical));
+    CHECK_FALSE(limiter.tryAcquire(endpoint, RequestPriority::Critical));
+
+    // Other endpoints have a budget of their own
+    CHECK(limiter.tryAcquire("/v2/private/order/cancel", RequestPriority::Critical));
+
+    now += milliseconds(999);
+    CHECK_FALSE(limiter.tryAcquire(endpoint, RequestPriority::Critical));
+
+    // The window resets at the announced time and refills the whole limit
+    now += milliseconds(1);
+    for (int i = 0; i < 5; i++) {
+        CHECK(limiter.tryAcquire(endpoint, RequestPriority::Backfill));
+    }
+    CHECK_FALSE(limiter.tryAcquire(endpoint, RequestPriority::Backfill));
+    for (int i = 0; i < 3; i++) {
+        CHECK(limiter.tryAcquire(endpoint, RequestPriority::Amend));
+    }
+    CHECK_FALSE(limiter.tryAcquire(endpoint, RequestPriority::Amend));
+
+    // Without a new response the bucket refills every window of the last response
+    now += seconds(1);
+    CHECK(limiter.tryAcquire(endpoint, RequestPriority::Backfill));
+}
+
+TEST_CASE("RateLimiter ignores incomplete and invalid headers") {
+    auto now = system_clock::time_point(milliseconds(1603101600000));
+    RateLimiter limiter([&now] { return now; });
+    const std::string endpoint = "/v2/private/order/create";
+
+    limiter.update(endpoint, cpr::Header{{"X-Bapi-Limit", "10"}, {"X-Bapi-Limit-Status", "0"}});
+    CHECK(limiter.tryAcquire(endpoint, RequestPriority::Backfill));
+
+    limiter.update(endpoint, cpr::Header{{"X-Bapi-Limit", "ten"},
+                                         {"X-Bapi-Limit-Status", "0"},
+                                         {"X-Bapi-Limit-Reset-Timestamp", "1603101601000"}});
+    CHECK(limiter.tryAcquire(endpoint, RequestPriority::Backfill));
+}
+
+TEST_CASE("RateLimiter reads the rate limit of a v2 response body") {
+    auto now = system_clock::time_point(milliseconds(1603101600000));
+    RateLimiter limiter([&now] { return now; });
+    const std::string endpoint = "/open-api/order/replace";
+    simdjson::dom::parser parser;
+
+    std::string body = R"({"ret_code":0,"ret_msg":"OK","ext_code":"","result":{"order_id":"1a2b3c"},)"
+                       R"("time_now":"1603101600.000000","rate_limit_status":2,"rate_limit_reset_ms":1603101601000,)"
+                       R"("rate_limit":10})";
+    CHECK(limiter.update(endpoint, parser.parse(body)));
+
+    CHECK(limiter.tryAcquire(endpoint, RequestPriority::Order));
+    CHECK_FALSE(limiter.tryAcquire(endpoint, RequestPriority::Amend));
+    CHECK(limiter.tryAcquire(endpoint, RequestPriority::Critical));
+    CHECK_FALSE(limiter.tryAcquire(endpoint, RequestPriority::Critical));
+
+    now += seconds(1);
+    CHECK(limiter.tryAcquire(endpoint, RequestPriority::Amend));
+
+    // Public responses have no rate limit in the body, they leave the bucket as is
+    std::string publicBody
+        = R"({"ret_code":0,"ret_msg":"OK","ext_code":"","result":[],"time_now":"1603101600.000000"})";
+    CHECK_FALSE(limiter.update("/v2/public/kline/list", parser.parse(publicBody)));
+    for (int i = 0; i < 20; i++) {
+        CHECK(limiter.tryAcquire("/v2/public/kline/list", RequestPriority::Backfill));
+    }
+}
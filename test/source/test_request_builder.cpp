@@ -0,0 +1,153 @@
+#include <cpr/cpr.h>
+#include <doctest/doctest.h>
+#include <openssl/hmac.h>
+
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include "../bytra/source/BybitRequests.h"
+#include "../bytra/source/RequestBuilder.cpp"
+
+namespace {
+    const std::string apiKey = "B2Rou0PLPpGqcU0Vu2";
+    const std::string apiSecret = "Y2hhbmdlbWVjaGFuZ2VtZWNoYW5nZW1l";
+    const long recvWindow = 1000;
+    const long timestamp = 1603101600000;
+
+    // The signing code the signer replaced
+    std::string HmacEncode(const std::string &param_str, const std::string &apiSecret) {
+        std::stringstream ss;
+        HMAC_CTX *h = HMAC_CTX_new();
+        unsigned int len;
+        unsigned char out[EVP_MAX_MD_SIZE];
+        HMAC_Init_ex(h, apiSecret.c_str(), apiSecret.length(), EVP_sha256(), nullptr);
+        HMAC_Update(h, (unsigned char *)param_str.c_str(), param_str.length());
+        HMAC_Final(h, out, &len);
+        HMAC_CTX_free(h);
+
+        for (unsigned int i = 0; i < len; i++) {
+            ss << std::setw(2) << std::setfill('0') << std::hex << static_cast<int>(out[i]);
+        }
+
+        return ss.str();
+    }
+
+    // Signs a payload the way the requests were built before the RequestBuilder
+    std::string legacyRequest(cpr::Payload payload) {
+        cpr::CurlHolder holder;
+        payload.AddPair({"sign", HmacEncode(payload.content, apiSecret)}, holder);
+        return payload.content;
+    }
+
+    // The signature has to match the legacy one for the fields in front of it
+    void checkSignature(const std::string_view &request) {
+        auto position = request.rfind("&sign=");
+        REQUIRE(position != std::string_view::npos);
+
+        std::string fields(request.substr(0, position));
+        std::string signature(request.substr(position + 6));
+        CHECK(signature == HmacEncode(fields, apiSecret));
+        CHECK(signature == HmacSigner(apiSecret).sign(fields));
+    }
+}  // namespace
+
+TEST_CASE("RequestBuilder create order requests") {
+    HmacSigner signer(apiSecret);
+    RequestBuilder builder;
+
+    std::string limit(builder.build(limitOrderRequest, signer, apiKey, "bytra-1", "Limit", Decimal{10420.5}, 100L,
+                                    recvWindow, std::optional<std::string_view>("true"), "Buy", "BTCUSD",
+                                    "PostOnly", timestamp));
+    CHECK(limit
+          == legacyRequest(cpr::Payload{{"api_key", apiKey},
+                                        {"order_link_id", "bytra-1"},
+                                        {"order_type", "Limit"},
+                                        {"price", "10420.5"},
+                                        {"qty", "100"},
+                                        {"recv_window", "1000"},
+                                        {"reduce_only", "true"},
+                                        {"side", "Buy"},
+                                        {"symbol", "BTCUSD"},
+                                        {"time_in_force", "PostOnly"},
+                                        {"timestamp", "1603101600000"}}));
+    checkSignature(limit);
+
+    // An empty reduce_only is left out
+    std::string market(builder.build(marketOrderRequest, signer, apiKey, "bytra-2", "Market", 25L, recvWindow,
+                                     std::optional<std::string_view>(), "Sell", "BTCUSD", "ImmediateOrCancel",
+                                     timestamp));
+    CHECK(market
+          == legacyRequest(cpr::Payload{{"api_key", apiKey},
+                                        {"order_link_id", "bytra-2"},
+                                        {"order_type", "Market"},
+                                        {"qty", "25"},
+                                        {"recv_window", "1000"},
+                                        {"side", "Sell"},
+                                        {"symbol", "BTCUSD"},
+                                        {"time_in_force", "ImmediateOrCancel"},
+                                        {"timestamp", "1603101600000"}}));
+    checkSignature(market);
+
+    // A prepared request sends the same bytes as one built in one go
+    PreparedRequest prepared = builder.prepare(limitOrderRequest, apiKey, Deferred{}, "Limit", Deferred{}, 100L,
+                                               recvWindow, std::optional<std::string_view>("true"), "Buy", "BTCUSD",
+                                               "PostOnly", Deferred{});
+    CHECK(prepared.isPreparedFrom(limitOrderRequest));
+    CHECK_FALSE(prepared.isPreparedFrom(marketOrderRequest));
+    CHECK(std::string(builder.build(prepared, signer, "bytra-1", Decimal{10420.5}, timestamp)) == limit);
+}
+
+TEST_CASE("RequestBuilder amend, cancel and trading stop requests") {
+    HmacSigner signer(apiSecret);
+    RequestBuilder builder;
+
+    std::string amend(builder.build(replaceOrderRequest, signer, apiKey, "1a2b3c", Decimal{10421}, recvWindow,
+                                    "BTCUSD", timestamp));
+    CHECK(amend
+          == legacyRequest(cpr::Payload{{"api_key", apiKey},
+                                        {"order_id", "1a2b3c"},
+                                        {"p_r_price", "10421"},
+                                        {"recv_window", "1000"},
+                                        {"symbol", "BTCUSD"},
+                                        {"timestamp", "1603101600000"}}));
+    checkSignature(amend);
+
+    std::string cancel(builder.build(cancelOrderRequest, signer, apiKey, "1a2b3c", recvWindow, "BTCUSD", timestamp));
+    CHECK(cancel
+          == legacyRequest(cpr::Payload{{"api_key", apiKey},
+                                        {"order_id", "1a2b3c"},
+                                        {"recv_window", "1000"},
+                                        {"symbol", "BTCUSD"},
+                                        {"timestamp", "1603101600000"}}));
+    checkSignature(cancel);
+
+    std::string tradingStop(builder.build(tradingStopRequest, signer, apiKey, recvWindow, "LastPrice",
+                                          Decimal{9870.25}, "BTCUSD", timestamp));
+    CHECK(tradingStop
+          == legacyRequest(cpr::Payload{{"api_key", apiKey},
+                                        {"recv_window", "1000"},
+                                        {"sl_trigger_by", "LastPrice"},
+                                        {"stop_loss", "9870.25"},
+                                        {"symbol", "BTCUSD"},
+                                        {"timestamp", "1603101600000"}}));
+    checkSignature(tradingStop);
+}
+
+TEST_CASE("RequestBuilder decimals") {
+    HmacSigner signer(apiSecret);
+    RequestBuilder builder;
+    constexpr RequestTemplate<1> request({"price"});
+
+    auto price = [&](const Decimal &value) {
+        std::string_view built = builder.build(request, signer, value);
+        return std::string(built.substr(0, built.find('&')));
+    };
+
+    CHECK(price(Decimal{10420.5}) == "price=10420.5");
+    CHECK(price(Decimal{10420.0}) == "price=10420");
+    CHECK(price(Decimal{0.0105}) == "price=0.0105");
+    CHECK(price(Decimal{1.23456}) == "price=1.2346");
+    CHECK(price(Decimal{-0.5}) == "price=-0.5");
+}
@@ -0,0 +1,42 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+
+#include "../bytra/source/TopicTable.h"
+
+TEST_CASE("TopicTable lookups") {
+    TopicTable<int> table;
+    CHECK(table.find("position") == nullptr);
+
+    std::vector<std::string> topics = {"position", "order", "execution", "orderBookL2_25.BTCUSD"};
+    for (auto timeframe : {"1", "3", "5", "15", "30", "60", "120", "240", "D", "W"}) {
+        topics.push_back(std::string("klineV2.") + timeframe + ".BTCUSD");
+    }
+
+    for (size_t i = 0; i < topics.size(); i++) {
+        table.add(topics[i], int(i));
+    }
+
+    // Every registered topic resolves to its handler
+    for (size_t i = 0; i < topics.size(); i++) {
+        const int *handler = table.find(topics[i]);
+        REQUIRE(handler != nullptr);
+        CHECK(*handler == int(i));
+    }
+
+    // Unknown topics, prefixes and topics of another symbol are not found
+    CHECK(table.find("klineV2.1.ETHUSD") == nullptr);
+    CHECK(table.find("klineV2.1") == nullptr);
+    CHECK(table.find("positions") == nullptr);
+    CHECK(table.find("") == nullptr);
+
+    // Adding a topic again replaces its handler
+    table.add("order", 42);
+    REQUIRE(table.find("order") != nullptr);
+    CHECK(*table.find("order") == 42);
+    CHECK(*table.find("position") == 0);
+
+    table.clear();
+    CHECK(table.find("order") == nullptr);
+}